@@ -48,6 +48,10 @@ class EcosSimulation:
 
         self.listener_configs = {}
 
+        self._set_num_threads = dll.ecos_simulation_set_num_threads
+        self._set_num_threads.argtypes = [c_void_p, c_size_t, c_bool]
+        self._set_num_threads.restype = c_bool
+
         self._init_simulation = dll.ecos_simulation_init
         self._init_simulation.argtypes = [c_void_p, c_double, c_char_p]
         self._init_simulation.restype = c_bool
@@ -102,6 +106,37 @@ class EcosSimulation:
         self._set_binary.argtypes = [c_void_p, c_char_p, POINTER(c_uint8), c_size_t]
         self._set_binary.restype = c_bool
 
+        self._resolve = dll.ecos_simulation_resolve
+        self._resolve.argtypes = [c_void_p, c_char_p, POINTER(c_size_t)]
+        self._resolve.restype = c_bool
+
+        self._get_integer_by_handle = dll.ecos_simulation_get_integer_by_handle
+        self._get_integer_by_handle.argtypes = [c_void_p, c_size_t, POINTER(c_int)]
+        self._get_integer_by_handle.restype = c_bool
+
+        self._get_real_by_handle = dll.ecos_simulation_get_real_by_handle
+        self._get_real_by_handle.argtypes = [c_void_p, c_size_t, POINTER(c_double)]
+        self._get_real_by_handle.restype = c_bool
+
+        self._get_bool_by_handle = dll.ecos_simulation_get_bool_by_handle
+        self._get_bool_by_handle.argtypes = [c_void_p, c_size_t, POINTER(c_bool)]
+        self._get_bool_by_handle.restype = c_bool
+
+        self._set_integer_by_handle = dll.ecos_simulation_set_integer_by_handle
+        self._set_integer_by_handle.argtypes = [c_void_p, c_size_t, c_int]
+        self._set_integer_by_handle.restype = c_bool
+
+        self._set_real_by_handle = dll.ecos_simulation_set_real_by_handle
+        self._set_real_by_handle.argtypes = [c_void_p, c_size_t, c_double]
+        self._set_real_by_handle.restype = c_bool
+
+        self._set_bool_by_handle = dll.ecos_simulation_set_bool_by_handle
+        self._set_bool_by_handle.argtypes = [c_void_p, c_size_t, c_bool]
+        self._set_bool_by_handle.restype = c_bool
+
+        # variables resolved so far, accessed without any lookup by name
+        self._handles = {}
+
         self._create_listener = dll.ecos_simulation_listener_create
         self._create_listener.argtypes = [ListenerConfig]
         self._create_listener.restype = c_void_p
@@ -280,19 +315,19 @@ class EcosSimulation:
 
     def get_integer(self, identifier: str):
         val = c_int()
-        if not self._get_integer(self.sim, identifier.encode(), byref(val)):
+        if not self._get_integer_by_handle(self.sim, self._handle(identifier), byref(val)):
             raise Exception(EcosLib.get_last_error())
         return val.value
 
     def get_real(self, identifier: str):
         val = c_double()
-        if not self._get_real(self.sim, identifier.encode(), byref(val)):
+        if not self._get_real_by_handle(self.sim, self._handle(identifier), byref(val)):
             raise Exception(EcosLib.get_last_error())
         return val.value
 
     def get_bool(self, identifier: str):
         val = c_bool()
-        if not self._get_bool(self.sim, identifier.encode(), byref(val)):
+        if not self._get_bool_by_handle(self.sim, self._handle(identifier), byref(val)):
             raise Exception(EcosLib.get_last_error())
         return val.value
 
@@ -303,15 +338,15 @@ class EcosSimulation:
         return buffer.value.decode()
 
     def set_integer(self, identifier: str, value: int):
-        if not self._set_integer(self.sim, identifier.encode(), value):
+        if not self._set_integer_by_handle(self.sim, self._handle(identifier), value):
             raise Exception(EcosLib.get_last_error())
 
     def set_real(self, identifier: str, value: float):
-        if not self._set_real(self.sim, identifier.encode(), value):
+        if not self._set_real_by_handle(self.sim, self._handle(identifier), value):
             raise Exception(EcosLib.get_last_error())
 
     def set_bool(self, identifier: str, value: bool):
-        if not self._set_bool(self.sim, identifier.encode(), value):
+        if not self._set_bool_by_handle(self.sim, self._handle(identifier), value):
             raise Exception(EcosLib.get_last_error())
 
     def set_string(self, identifier: str, value: str):
@@ -322,6 +357,25 @@ class EcosSimulation:
         if not self._set_binary(self.sim, identifier.encode(), (value_type := (c_uint8 * len(value))(*value)), len(value)):
             raise Exception(EcosLib.get_last_error())
 
+    def _handle(self, identifier: str) -> int:
+        handle = self._handles.get(identifier)
+        if handle is None:
+            val = c_size_t()
+            if not self._resolve(self.sim, identifier.encode(), byref(val)):
+                raise Exception(EcosLib.get_last_error())
+            handle = self._handles[identifier] = val.value
+        return handle
+
+    def set_num_threads(self, num_threads: int, pin: bool = False):
+        """
+        Set the number of threads used for stepping the simulation.
+        Args:
+            num_threads (int): Number of threads, including the calling thread. 0 selects a suitable number automatically.
+            pin (bool): Whether to pin worker threads to individual cores. Defaults to False.
+        """
+        if not self._set_num_threads(self.sim, num_threads, pin):
+            raise Exception(EcosLib.get_last_error())
+
     def init(self, start_time: int = 0, parameter_set: str = None):
         """
         Initialize the simulation with a start time and an optional parameter set.
@@ -0,0 +1,54 @@
+
+#ifndef ECOS_ADAPTIVE_STEP_ALGORITHM_HPP
+#define ECOS_ADAPTIVE_STEP_ALGORITHM_HPP
+
+#include "algorithm.hpp"
+
+#include <memory>
+
+namespace ecos
+{
+
+/**
+ * \brief Error-controlled adaptive macro step algorithm for co-simulation orchestration.
+ *
+ * - Each macro step is taken twice from a saved state: once as a full step and once as two half steps
+ *   with connection data exchanged in between. The difference in connected real outputs estimates the coupling error.
+ * - A step is accepted when the error, relative to tolerance * (1 + |value|), is within bounds.
+ *   Otherwise all instances are rolled back and the step is retried with a smaller step size.
+ * - The step size grows when signals are smooth, and is kept within [minStepSize, maxStepSize].
+ *   Steps at the minimum step size are always accepted.
+ * - Requires all model instances to support get/set state, otherwise the initial step size is used throughout.
+ *   Step size hints of individual models are not taken into account.
+ */
+class adaptive_step_algorithm : public algorithm
+{
+
+public:
+    adaptive_step_algorithm(double initialStepSize, double minStepSize, double maxStepSize, double tolerance = 1e-4, bool parallel = true);
+
+    void model_instance_added(model_instance* instance) override;
+
+    void connection_added(connection* c) override;
+
+    double step(double currentTime) override;
+
+    [[nodiscard]] bool updates_all_instances() const override;
+
+    void set_thread_pool(thread_pool* pool) override;
+
+    void terminate() override;
+
+    // Step size to be attempted by the next step.
+    [[nodiscard]] double step_size() const;
+
+    ~adaptive_step_algorithm() override;
+
+private:
+    class impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+} // namespace ecos
+
+#endif // ECOS_ADAPTIVE_STEP_ALGORITHM_HPP
@@ -2,11 +2,16 @@
 #ifndef ECOS_ALGORITHM_HPP
 #define ECOS_ALGORITHM_HPP
 
+#include "ecos/connection.hpp"
 #include "ecos/model_instance.hpp"
 
+#include <vector>
+
 namespace ecos
 {
 
+class thread_pool;
+
 /**
  * /brief Abstract base class for algorithms used for co-simulation orchestration.
  */
@@ -15,8 +20,34 @@ struct algorithm
 
     virtual void model_instance_added(model_instance* instance) = 0;
 
+    // Invoked for every connection made between model instances of the simulation.
+    // Connection data is transferred by the simulation after each step regardless.
+    virtual void connection_added(connection* c) { }
+
     virtual double step(double currentTime) = 0;
 
+    // Whether step() applies pending inputs and fetches outputs of the instances it updates, in which case the simulation
+    // leaves this to the algorithm. Instances not updated by a step, e.g. ones not due with a multi-rate schedule,
+    // keep pending inputs (including values set through the API) until the algorithm next updates them.
+    // If not, the simulation applies inputs and fetches outputs of every instance after connection data has been transferred.
+    [[nodiscard]] virtual bool updates_all_instances() const
+    {
+        return false;
+    }
+
+    // Model instances (by the order in which they were added) reading their inputs during the next step.
+    // Connection data is then only transferred into these, nullptr means all instances.
+    [[nodiscard]] virtual const std::vector<size_t>* pending_consumers() const
+    {
+        return nullptr;
+    }
+
+    // Worker pool owned by the simulation, to be used for any parallel work. Remains valid until replaced.
+    virtual void set_thread_pool(thread_pool* pool) { }
+
+    // Invoked when the simulation terminates.
+    virtual void terminate() { }
+
     virtual ~algorithm() = default;
 };
 
@@ -0,0 +1,50 @@
+
+#ifndef ECOS_DATAFLOW_ALGORITHM_HPP
+#define ECOS_DATAFLOW_ALGORITHM_HPP
+
+#include "algorithm.hpp"
+
+#include <memory>
+
+namespace ecos
+{
+
+/**
+ * \brief Dataflow (asynchronous Jacobi) algorithm for co-simulation orchestration.
+ *
+ * - Each step advances the simulation by a window of base steps (ticks) of the given step size.
+ * - Within a window, every instance tick is a task which becomes ready as soon as the instance has completed
+ *   the previous tick and all of its upstream instances have produced their outputs for that tick.
+ *   Instances may run ahead of their consumers by up to maxRunAhead ticks, which pipelines chains of instances over threads.
+ * - Results are identical to fixed_step_algorithm with the same step size,
+ *   but listeners (and thus any observation of variables) only see the state at window boundaries.
+ * - Connections that can not be exchanged between ticks (e.g. type-converting connections) reduce the window to a single tick.
+ */
+class dataflow_algorithm : public algorithm
+{
+
+public:
+    explicit dataflow_algorithm(double stepSize, unsigned window = 10, unsigned maxRunAhead = 2);
+
+    void model_instance_added(model_instance* instance) override;
+
+    void connection_added(connection* c) override;
+
+    double step(double currentTime) override;
+
+    [[nodiscard]] bool updates_all_instances() const override;
+
+    [[nodiscard]] const std::vector<size_t>* pending_consumers() const override;
+
+    void set_thread_pool(thread_pool* pool) override;
+
+    ~dataflow_algorithm() override;
+
+private:
+    class impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+} // namespace ecos
+
+#endif // ECOS_DATAFLOW_ALGORITHM_HPP
@@ -12,8 +12,16 @@ namespace ecos
 /**
  * \brief Fixed-step algorithm for co-simulation orchestration.
  *
- * - Supports parallel execution of model instances.
+ * - Supports parallel execution of model instances, using the thread pool of the simulation when available.
+ *   Instances are distributed over threads based on their measured step time, and re-distributed when the costs drift.
+ *   Per-thread utilisation is reported on termination.
  * - Supports multi-variate step-size for individual models.
+ *   Which instances step at each base step is tabulated over the hyperperiod of their decimation factors.
+ *   Only instances due for a step are updated, and only their inputs are transferred.
+ *   Values set on other instances, including through the API, are applied when they are next due.
+ * - Each instance due for a step applies its inputs, steps and fetches its outputs within a single task.
+ *   Inputs transferred after a step are applied at the beginning of the next one, so post-step listeners
+ *   (e.g. csv_writer) see direct-feedthrough outputs as they were before those inputs were applied.
  */
 class fixed_step_algorithm : public algorithm
 {
@@ -25,6 +33,14 @@ public:
 
     double step(double currentTime) override;
 
+    [[nodiscard]] bool updates_all_instances() const override;
+
+    [[nodiscard]] const std::vector<size_t>* pending_consumers() const override;
+
+    void set_thread_pool(thread_pool* pool) override;
+
+    void terminate() override;
+
     ~fixed_step_algorithm() override;
 
 private:
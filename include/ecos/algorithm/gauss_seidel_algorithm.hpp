@@ -0,0 +1,58 @@
+
+#ifndef ECOS_GAUSS_SEIDEL_ALGORITHM_HPP
+#define ECOS_GAUSS_SEIDEL_ALGORITHM_HPP
+
+#include "algorithm.hpp"
+
+#include <memory>
+#include <string>
+
+namespace ecos
+{
+
+/**
+ * \brief Gauss-Seidel algorithm for co-simulation orchestration.
+ *
+ * - Instances are stepped in the dependency order given by their connections.
+ *   Inputs are transferred right before an instance steps, so it sees the outputs its upstream instances computed within the same step.
+ *   Only delayed inputs are transferred by the simulation after each step.
+ * - Cycles are broken by delaying connections, which then carry the value from the previous step (as with Jacobi coupling).
+ *   Within a cycle, instances with a higher priority step first, ties are resolved by the order in which instances were added.
+ *   Specific inputs may also be delayed explicitly.
+ * - Instances are grouped into stages (wavefronts) of mutually independent instances, each of which is stepped in parallel.
+ * - Supports multi-variate step-size for individual models.
+ */
+class gauss_seidel_algorithm : public algorithm
+{
+
+public:
+    explicit gauss_seidel_algorithm(double stepSize, bool parallel = true);
+
+    // Instances with a higher priority are stepped first when part of a cycle. Defaults to 0.
+    void set_priority(const std::string& instanceName, int priority);
+
+    // Connections into variables matching the pattern (wildcards allowed) always carry the value from the previous step.
+    void delay_input(const variable_identifier& pattern);
+
+    void model_instance_added(model_instance* instance) override;
+
+    void connection_added(connection* c) override;
+
+    double step(double currentTime) override;
+
+    [[nodiscard]] bool updates_all_instances() const override;
+
+    [[nodiscard]] const std::vector<size_t>* pending_consumers() const override;
+
+    void set_thread_pool(thread_pool* pool) override;
+
+    ~gauss_seidel_algorithm() override;
+
+private:
+    class impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+} // namespace ecos
+
+#endif // ECOS_GAUSS_SEIDEL_ALGORITHM_HPP
@@ -4,7 +4,9 @@
 
 #include "ecos/property.hpp"
 
+#include <cmath>
 #include <functional>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
@@ -15,6 +17,17 @@ struct connection
 {
     virtual void transferData() = 0;
 
+    // Endpoints of the connection, if known.
+    [[nodiscard]] virtual const property* source_property() const
+    {
+        return nullptr;
+    }
+
+    [[nodiscard]] virtual const property* sink_property() const
+    {
+        return nullptr;
+    }
+
     virtual ~connection() = default;
 };
 
@@ -42,6 +55,16 @@ struct connection_te : public connection
         }
     }
 
+    [[nodiscard]] const property* source_property() const override
+    {
+        return source;
+    }
+
+    [[nodiscard]] const property* sink_property() const override
+    {
+        return sink;
+    }
+
 protected:
     connection_te(property_t<T>* source, property_t<T>* sink)
         : source(source)
@@ -79,17 +102,78 @@ public:
         if (modifier) {
             value = modifier.value()(value);
         }
-        sink->set_value(value);
+        if (accept(value)) {
+            sink->set_value(value);
+        }
     }
 
     void set_modifier(std::optional<std::function<double(double)>> mod)
     {
         modifier = std::move(mod);
     }
+
+    // Changes smaller than the deadband are not propagated to the sink. A deadband of 0 propagates every value.
+    void set_deadband(double deadband)
+    {
+        if (deadband < 0) {
+            throw std::runtime_error("Deadband must be non-negative!");
+        }
+        deadband_ = deadband;
+        lastValue_ = std::nullopt;
+    }
+
+    [[nodiscard]] double deadband() const
+    {
+        return deadband_;
+    }
+
+    // Number of values held back by the deadband.
+    [[nodiscard]] size_t num_suppressed() const
+    {
+        return numSuppressed_;
+    }
+
+    // Returns true if the value should be propagated, in which case it becomes the new reference value.
+    bool accept(double value)
+    {
+        if (deadband_ > 0) {
+            if (lastValue_ && std::abs(value - *lastValue_) < deadband_) {
+                ++numSuppressed_;
+                return false;
+            }
+            lastValue_ = value;
+        }
+        return true;
+    }
+
+    // Forgets the last propagated value, so that the next value is always propagated.
+    void reset_deadband()
+    {
+        lastValue_ = std::nullopt;
+    }
+
+    // The last propagated value the deadband applies to, e.g. to be saved and restored along with instance states.
+    [[nodiscard]] std::optional<double> deadband_reference() const
+    {
+        return lastValue_;
+    }
+
+    void set_deadband_reference(std::optional<double> value)
+    {
+        lastValue_ = value;
+    }
+
+private:
+    double deadband_{0};
+    std::optional<double> lastValue_;
+    size_t numSuppressed_{0};
 };
 using int_connection = connection_t<int>;
 using bool_connection = connection_t<bool>;
 using string_connection = connection_t<std::string>;
+using int64_connection = connection_t<int64_t>;
+using uint64_connection = connection_t<uint64_t>;
+using float32_connection = connection_t<float>;
 
 
 } // namespace ecos
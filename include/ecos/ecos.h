@@ -54,6 +54,9 @@ LIBECOS_API void ecos_parameter_set_add_bool(ecos_parameter_set_t* pps, const ch
 LIBECOS_API ecos_simulation_t* ecos_simulation_create_from_ssp(const char* sspPath, double stepSize);
 LIBECOS_API ecos_simulation_t* ecos_simulation_create_from_structure(ecos_simulation_structure_t* structure, double stepSize);
 
+// Number of threads used for stepping, 0 -> automatic. Optionally pins worker threads to individual cores.
+LIBECOS_API bool ecos_simulation_set_num_threads(ecos_simulation_t* sim, size_t numThreads, bool pin = false);
+
 LIBECOS_API bool ecos_simulation_init(ecos_simulation_t* sim, double startTime = 0, const char* parameterSet = nullptr);
 
 LIBECOS_API double ecos_simulation_step(ecos_simulation_t* sim, size_t numSteps = 1);
@@ -74,6 +77,34 @@ LIBECOS_API bool ecos_simulation_set_bool(ecos_simulation_t* sim, const char* id
 LIBECOS_API bool ecos_simulation_set_string(ecos_simulation_t* sim, const char* identifier, const char* value);
 LIBECOS_API bool ecos_simulation_set_binary(ecos_simulation_t* sim, const char* identifier, const uint8_t* value, size_t len);
 
+// Resolves a variable once, such that it can be accessed repeatedly without any lookup by name.
+LIBECOS_API bool ecos_simulation_resolve(ecos_simulation_t* sim, const char* identifier, size_t* handle);
+
+LIBECOS_API bool ecos_simulation_get_integer_by_handle(ecos_simulation_t* sim, size_t handle, int* value);
+LIBECOS_API bool ecos_simulation_get_real_by_handle(ecos_simulation_t* sim, size_t handle, double* value);
+LIBECOS_API bool ecos_simulation_get_bool_by_handle(ecos_simulation_t* sim, size_t handle, bool* value);
+
+LIBECOS_API bool ecos_simulation_set_integer_by_handle(ecos_simulation_t* sim, size_t handle, int value);
+LIBECOS_API bool ecos_simulation_set_real_by_handle(ecos_simulation_t* sim, size_t handle, double value);
+LIBECOS_API bool ecos_simulation_set_bool_by_handle(ecos_simulation_t* sim, size_t handle, bool value);
+
+// FMI 3 variables of type Int64, UInt64 and Float32.
+LIBECOS_API bool ecos_simulation_get_int64(ecos_simulation_t* sim, const char* identifier, int64_t* value);
+LIBECOS_API bool ecos_simulation_get_uint64(ecos_simulation_t* sim, const char* identifier, uint64_t* value);
+LIBECOS_API bool ecos_simulation_get_float32(ecos_simulation_t* sim, const char* identifier, float* value);
+
+LIBECOS_API bool ecos_simulation_set_int64(ecos_simulation_t* sim, const char* identifier, int64_t value);
+LIBECOS_API bool ecos_simulation_set_uint64(ecos_simulation_t* sim, const char* identifier, uint64_t value);
+LIBECOS_API bool ecos_simulation_set_float32(ecos_simulation_t* sim, const char* identifier, float value);
+
+LIBECOS_API bool ecos_simulation_get_int64_by_handle(ecos_simulation_t* sim, size_t handle, int64_t* value);
+LIBECOS_API bool ecos_simulation_get_uint64_by_handle(ecos_simulation_t* sim, size_t handle, uint64_t* value);
+LIBECOS_API bool ecos_simulation_get_float32_by_handle(ecos_simulation_t* sim, size_t handle, float* value);
+
+LIBECOS_API bool ecos_simulation_set_int64_by_handle(ecos_simulation_t* sim, size_t handle, int64_t value);
+LIBECOS_API bool ecos_simulation_set_uint64_by_handle(ecos_simulation_t* sim, size_t handle, uint64_t value);
+LIBECOS_API bool ecos_simulation_set_float32_by_handle(ecos_simulation_t* sim, size_t handle, float value);
+
 LIBECOS_API bool ecos_simulation_terminate(ecos_simulation_t* sim);
 LIBECOS_API bool ecos_simulation_reset(ecos_simulation_t* sim);
 LIBECOS_API void ecos_simulation_destroy(ecos_simulation_t* sim);
@@ -23,6 +23,9 @@ struct simulation_listener
     virtual void post_init(simulation& sim);
 
     virtual void pre_step(simulation& sim);
+    // Invoked once the outputs of the step have been fetched and transferred over the connections.
+    // With algorithms applying inputs at the beginning of the next step, e.g. fixed_step_algorithm, outputs
+    // depending directly on inputs (direct feedthrough) are seen as they were before the transferred inputs were applied.
     virtual void post_step(simulation& sim);
 
     virtual void post_terminate(simulation& sim);
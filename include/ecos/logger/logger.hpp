@@ -4,6 +4,10 @@
 
 #include <spdlog/fmt/fmt.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace ecos::log
 {
 
@@ -21,6 +25,29 @@ void set_logging_level(level lvl);
 
 void log(level lvl, std::string_view msg);
 
+// Messages collected while captured, see scoped_capture.
+struct captured_messages
+{
+    std::vector<std::pair<level, std::string>> messages;
+
+    // Logs the collected messages in the order they were captured, and clears them.
+    void flush();
+};
+
+// Collects messages logged by the current thread during its lifetime, rather than emitting them right away.
+// Allows work done concurrently to be logged in a deterministic order.
+class scoped_capture
+{
+public:
+    explicit scoped_capture(captured_messages& target);
+    scoped_capture(const scoped_capture&) = delete;
+    scoped_capture& operator=(const scoped_capture&) = delete;
+    ~scoped_capture();
+
+private:
+    captured_messages* previous_;
+};
+
 template<typename... Args>
 void trace(fmt::format_string<Args...> fmt, Args&&... args)
 {
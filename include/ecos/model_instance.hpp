@@ -4,6 +4,7 @@
 
 #include "ecos/property.hpp"
 #include "ecos/scalar.hpp"
+#include "ecos/value_store.hpp"
 
 #include <stdexcept>
 #include <unordered_map>
@@ -78,6 +79,16 @@ public:
         return properties_;
     }
 
+    // Number of values this instance keeps in a shared value_store.
+    // Instances returning an empty count manage their own storage.
+    [[nodiscard]] virtual value_count value_layout() const
+    {
+        return {};
+    }
+
+    // Moves the values of this instance into its slice of a simulation-wide value_store.
+    virtual void bind_value_store(value_store& /*store*/, const value_slice& /*slice*/) { }
+
     [[nodiscard]] virtual bool can_get_and_set_state() const
     {
         return false;
@@ -5,11 +5,13 @@
 #include "ecos/variable_identifier.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -30,19 +32,72 @@ struct property
         : id_(std::move(id))
     { }
 
-    [[nodiscard]] variable_identifier id() const
+    [[nodiscard]] const variable_identifier& id() const
     {
         return id_;
     }
 
     virtual void applySet() = 0;
 
+    // Declares that the value is read after every step, e.g. as the source of a connection,
+    // such that it may be fetched along with other such values. Values read now and then need not be subscribed to.
+    virtual void subscribe() const { }
+
+    // Offset of the backing value within the simulation value_store, if the property is store backed.
+    [[nodiscard]] std::optional<size_t> store_index() const
+    {
+        return storeIndex_;
+    }
+
+    void bind_store_index(std::optional<size_t> index)
+    {
+        storeIndex_ = index;
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const property& p);
 
     virtual ~property() = default;
 
 protected:
     variable_identifier id_;
+    std::optional<size_t> storeIndex_;
+};
+
+
+/* *
+ * \brief Values of a single type held by a model instance, addressed by slot.
+ *
+ * Properties backed by a value buffer read the values directly, and only go through
+ * a virtual call for the (less frequent) sets and reads of outdated values.
+ */
+template<class T>
+struct value_buffer
+{
+    using stored_type = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+    // Current values, indexed by slot. Must be kept up to date if the values are moved.
+    stored_type* values{nullptr};
+
+    // Generation at which the value of each slot was last updated, compared against the current generation.
+    // Values are never outdated when null.
+    const uint64_t* fetchedAt{nullptr};
+    const uint64_t* generation{nullptr};
+
+    [[nodiscard]] bool fresh(size_t slot) const
+    {
+        return !fetchedAt || fetchedAt[slot] >= *generation;
+    }
+
+    // Keeps the value of a slot up to date from here on.
+    virtual void subscribe(size_t slot) = 0;
+
+    // Brings the outdated value of a slot up to date.
+    virtual void refresh(size_t slot) = 0;
+
+    // Queues a value to be set.
+    virtual void set(size_t slot, const T& value) = 0;
+
+    virtual ~value_buffer() = default;
 };
 
 
@@ -59,10 +114,17 @@ struct property_t : property
         , setter(setter)
     { }
 
+    // Constructs a property reading and writing a slot of a value buffer, which must outlive the property.
+    property_t(const variable_identifier& id, value_buffer<T>& buffer, size_t slot)
+        : property(id)
+        , buffer_(&buffer)
+        , slot_(slot)
+    { }
+
     [[nodiscard]] T get_value() const
     {
-        auto value = getter();
-        if (outputModifier_) {
+        T value = buffer_ ? read_buffer() : getter();
+        if (outputModifier_) [[unlikely]] {
             value = outputModifier_->operator()(value);
         }
         return value;
@@ -77,16 +139,27 @@ struct property_t : property
     // Apply the cached set value to the property.
     void applySet() override
     {
-        if (setter && cachedSet) {
+        if ((buffer_ || setter) && cachedSet) {
             T value = cachedSet.value();
             if (inputModifier_) {
                 value = inputModifier_->operator()(value);
             }
-            setter->operator()(value);
+            if (buffer_) {
+                buffer_->set(slot_, value);
+            } else {
+                setter->operator()(value);
+            }
             cachedSet = std::nullopt;
         }
     }
 
+    void subscribe() const override
+    {
+        if (buffer_) {
+            buffer_->subscribe(slot_);
+        }
+    }
+
     void set_input_modifier(std::function<T(const T&)> modifier)
     {
         inputModifier_ = std::move(modifier);
@@ -97,6 +170,11 @@ struct property_t : property
         inputModifier_ = std::nullopt;
     }
 
+    [[nodiscard]] bool has_input_modifier() const
+    {
+        return inputModifier_.has_value();
+    }
+
     // Assign an output modifier to transform any value being set
     void set_output_modifier(std::function<T(const T&)> modifier)
     {
@@ -109,12 +187,28 @@ struct property_t : property
         outputModifier_ = std::nullopt;
     }
 
+    [[nodiscard]] bool has_output_modifier() const
+    {
+        return outputModifier_.has_value();
+    }
+
 private:
     std::optional<T> cachedSet;
 
     std::function<T()> getter;
     std::optional<std::function<void(const T&)>> setter = std::nullopt;
 
+    value_buffer<T>* buffer_{nullptr};
+    size_t slot_{0};
+
+    T read_buffer() const
+    {
+        if (!buffer_->fresh(slot_)) [[unlikely]] {
+            buffer_->refresh(slot_);
+        }
+        return static_cast<T>(buffer_->values[slot_]);
+    }
+
     std::optional<std::function<T(const T&)>> inputModifier_;
     std::optional<std::function<T(const T&)>> outputModifier_;
 };
@@ -153,6 +247,15 @@ public:
         for (auto& p : binaryProperties_ | std::views::values) {
             p.applySet();
         }
+        for (auto& p : int64Properties_ | std::views::values) {
+            p.applySet();
+        }
+        for (auto& p : uint64Properties_ | std::views::values) {
+            p.applySet();
+        }
+        for (auto& p : float32Properties_ | std::views::values) {
+            p.applySet();
+        }
 
         for (const auto& l : listeners_) {
             l->post_sets();
@@ -211,6 +314,33 @@ public:
         return nullptr;
     }
 
+    property_t<int64_t>* get_int64_property(const std::string& name)
+    {
+        if (int64Properties_.contains(name)) {
+            auto& property = int64Properties_.at(name);
+            return &property;
+        }
+        return nullptr;
+    }
+
+    property_t<uint64_t>* get_uint64_property(const std::string& name)
+    {
+        if (uint64Properties_.contains(name)) {
+            auto& property = uint64Properties_.at(name);
+            return &property;
+        }
+        return nullptr;
+    }
+
+    property_t<float>* get_float32_property(const std::string& name)
+    {
+        if (float32Properties_.contains(name)) {
+            auto& property = float32Properties_.at(name);
+            return &property;
+        }
+        return nullptr;
+    }
+
     [[nodiscard]] const std::unordered_map<std::string, property_t<double>>& get_reals() const
     {
         return realProperties_;
@@ -236,6 +366,21 @@ public:
         return binaryProperties_;
     }
 
+    [[nodiscard]] const std::unordered_map<std::string, property_t<int64_t>>& get_int64s() const
+    {
+        return int64Properties_;
+    }
+
+    [[nodiscard]] const std::unordered_map<std::string, property_t<uint64_t>>& get_uint64s() const
+    {
+        return uint64Properties_;
+    }
+
+    [[nodiscard]] const std::unordered_map<std::string, property_t<float>>& get_float32s() const
+    {
+        return float32Properties_;
+    }
+
     void add_real_property(property_t<double> p)
     {
         realProperties_.emplace(p.id().variable_name(), std::move(p));
@@ -261,6 +406,21 @@ public:
         boolProperties_.emplace(p.id().variable_name(), std::move(p));
     }
 
+    void add_int64_property(property_t<int64_t> p)
+    {
+        int64Properties_.emplace(p.id().variable_name(), std::move(p));
+    }
+
+    void add_uint64_property(property_t<uint64_t> p)
+    {
+        uint64Properties_.emplace(p.id().variable_name(), std::move(p));
+    }
+
+    void add_float32_property(property_t<float> p)
+    {
+        float32Properties_.emplace(p.id().variable_name(), std::move(p));
+    }
+
     [[nodiscard]] bool has_property(const std::string& name) const
     {
         const auto& names = get_property_names();
@@ -287,6 +447,15 @@ public:
         std::ranges::transform(binaryProperties_, std::back_inserter(names), [](auto& pair) {
             return pair.first;
         });
+        std::ranges::transform(int64Properties_, std::back_inserter(names), [](auto& pair) {
+            return pair.first;
+        });
+        std::ranges::transform(uint64Properties_, std::back_inserter(names), [](auto& pair) {
+            return pair.first;
+        });
+        std::ranges::transform(float32Properties_, std::back_inserter(names), [](auto& pair) {
+            return pair.first;
+        });
         return names;
     }
 
@@ -302,6 +471,9 @@ private:
     std::unordered_map<std::string, property_t<double>> realProperties_;
     std::unordered_map<std::string, property_t<std::string>> stringProperties_;
     std::unordered_map<std::string, property_t<std::vector<uint8_t>>> binaryProperties_;
+    std::unordered_map<std::string, property_t<int64_t>> int64Properties_;
+    std::unordered_map<std::string, property_t<uint64_t>> uint64Properties_;
+    std::unordered_map<std::string, property_t<float>> float32Properties_;
 };
 
 } // namespace ecos
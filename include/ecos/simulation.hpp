@@ -6,6 +6,7 @@
 #include "ecos/connection.hpp"
 #include "ecos/listeners/simulation_listener.hpp"
 #include "ecos/model_instance.hpp"
+#include "ecos/value_store.hpp"
 #include "ecos/variable_identifier.hpp"
 
 #include <filesystem>
@@ -15,6 +16,25 @@
 namespace ecos
 {
 
+// Opaque reference to a variable of a simulation, obtained once through simulation::resolve.
+// Accessing a variable through its handle involves no lookup by name.
+class variable_handle
+{
+
+public:
+    explicit variable_handle(size_t index)
+        : index_(index)
+    { }
+
+    [[nodiscard]] size_t index() const
+    {
+        return index_;
+    }
+
+private:
+    size_t index_;
+};
+
 /* *
  * \brief Represents a co-simulation.
  *
@@ -42,6 +62,16 @@ public:
 
     [[nodiscard]] bool terminated() const;
 
+    // Sets the number of threads (including the calling thread) used for stepping.
+    // 0 selects the number of hardware threads, limited by the number of model instances.
+    // Optionally pins worker threads to individual cores. Must not be called while stepping.
+    void set_num_threads(size_t numThreads, bool pinThreads = false);
+
+    // Convergence criteria for instances connected in a cycle during initialization.
+    // Connected real values are converged when changing less than tolerance * (1 + |value|) between passes.
+    // Defaults to a tolerance of 1e-6 and at most 100 passes.
+    void set_init_tolerance(double tolerance, size_t maxIterations = 100);
+
     void init(const std::string& parameterSet)
     {
         init(std::nullopt, parameterSet);
@@ -89,14 +119,41 @@ public:
     // Creates a connection between two string-valued variables.
     string_connection* make_string_connection(const variable_identifier& source, const variable_identifier& sink);
 
+    // Creates a connection between two (FMI 3) 64-bit integer variables.
+    int64_connection* make_int64_connection(const variable_identifier& source, const variable_identifier& sink);
+
+    // Creates a connection between two (FMI 3) unsigned 64-bit integer variables.
+    uint64_connection* make_uint64_connection(const variable_identifier& source, const variable_identifier& sink);
+
+    // Creates a connection between two (FMI 3) single precision variables.
+    float32_connection* make_float32_connection(const variable_identifier& source, const variable_identifier& sink);
+
     [[nodiscard]] property_t<double>* get_real_property(const variable_identifier& identifier) const;
     [[nodiscard]] property_t<int>* get_int_property(const variable_identifier& identifier) const;
     [[nodiscard]] property_t<std::string>* get_string_property(const variable_identifier& identifier) const;
     [[nodiscard]] property_t<std::vector<uint8_t>>* get_binary_property(const variable_identifier& identifier) const;
     [[nodiscard]] property_t<bool>* get_bool_property(const variable_identifier& identifier) const;
+    [[nodiscard]] property_t<int64_t>* get_int64_property(const variable_identifier& identifier) const;
+    [[nodiscard]] property_t<uint64_t>* get_uint64_property(const variable_identifier& identifier) const;
+    [[nodiscard]] property_t<float>* get_float32_property(const variable_identifier& identifier) const;
+
+    // Resolves a variable for repeated access through get/set. Throws if no such variable exists.
+    [[nodiscard]] variable_handle resolve(const variable_identifier& identifier) const;
+
+    // Reads a resolved variable of type double, int, bool, std::string, std::vector<uint8_t>, int64_t, uint64_t or float.
+    // Throws if the variable is of another type.
+    template<class T>
+    [[nodiscard]] T get(variable_handle handle) const;
+
+    // Sets a resolved variable, to be applied with the next step. Throws if the variable is of another type.
+    template<class T>
+    void set(variable_handle handle, const T& value);
 
     [[nodiscard]] const std::vector<std::unique_ptr<model_instance>>& get_instances() const;
 
+    // Shared storage backing the variables of (FMI-based) model instances. Populated by init().
+    [[nodiscard]] const value_store& get_value_store() const;
+
     [[nodiscard]] std::vector<variable_identifier> identifiers() const;
 
     ~simulation();
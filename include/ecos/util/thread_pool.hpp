@@ -0,0 +1,55 @@
+#ifndef ECOS_THREAD_POOL_HPP
+#define ECOS_THREAD_POOL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace ecos
+{
+
+/**
+ * \brief Persistent pool of worker threads for fork/join style parallelism.
+ *
+ * Workers are created once and kept alive between jobs. A job is split into per-thread task ranges,
+ * idle threads steal tasks from the back of other threads' ranges. Waiting threads spin briefly
+ * before parking, which keeps the fork/join overhead of short, frequent jobs (e.g. a time step) low.
+ *
+ * Jobs must be submitted from a single thread at a time, which also takes part in executing the job.
+ */
+class thread_pool
+{
+
+public:
+    // numThreads includes the submitting thread, 0 selects the number of hardware threads.
+    explicit thread_pool(size_t numThreads = 0, bool pinThreads = false);
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool(thread_pool&&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    thread_pool& operator=(thread_pool&&) = delete;
+
+    [[nodiscard]] size_t num_threads() const;
+
+    // Invokes f(i) for every i in [0, numTasks) and blocks until all tasks are done.
+    // The first exception thrown by a task is re-thrown once the job has completed.
+    void parallel_for(size_t numTasks, const std::function<void(size_t)>& f);
+
+    // As above, but with an explicit initial distribution of the tasks. Holds num_threads() + 1 ascending offsets,
+    // tasks [offsets[t], offsets[t + 1]) are queued on thread t. Idle threads still steal work.
+    void parallel_for(std::span<const size_t> offsets, const std::function<void(size_t)>& f);
+
+    // Index of the calling thread within the pool currently executing it, 0 for the submitting thread.
+    [[nodiscard]] static size_t current_thread_index();
+
+    ~thread_pool();
+
+private:
+    class impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+} // namespace ecos
+
+#endif // ECOS_THREAD_POOL_HPP
@@ -0,0 +1,149 @@
+#ifndef ECOS_VALUE_STORE_HPP
+#define ECOS_VALUE_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ecos
+{
+
+// Number of values of each type a model instance keeps in a value_store.
+struct value_count
+{
+    size_t reals{0};
+    size_t integers{0};
+    size_t booleans{0};
+    size_t strings{0};
+    size_t int64s{0};
+    size_t uint64s{0};
+    size_t float32s{0};
+};
+
+// Location of the values owned by a single model instance within a value_store.
+struct value_slice
+{
+    size_t realOffset{0};
+    size_t integerOffset{0};
+    size_t booleanOffset{0};
+    size_t stringOffset{0};
+    size_t int64Offset{0};
+    size_t uint64Offset{0};
+    size_t float32Offset{0};
+
+    value_count count;
+};
+
+/**
+ * \brief Simulation-wide, structure-of-arrays storage for model instance variables.
+ *
+ * Each model instance owns a contiguous slice of every array. Values are addressed by plain offsets,
+ * which remain valid until the store is cleared. Booleans are stored as bytes.
+ *
+ * Note that allocate() may invalidate any pointer previously handed out;
+ * pointers must only be obtained once all slices have been allocated.
+ */
+class value_store
+{
+
+public:
+    value_slice allocate(const value_count& count)
+    {
+        value_slice slice;
+        slice.realOffset = reals_.size();
+        slice.integerOffset = integers_.size();
+        slice.booleanOffset = booleans_.size();
+        slice.stringOffset = strings_.size();
+        slice.int64Offset = int64s_.size();
+        slice.uint64Offset = uint64s_.size();
+        slice.float32Offset = float32s_.size();
+        slice.count = count;
+
+        reals_.resize(reals_.size() + count.reals);
+        integers_.resize(integers_.size() + count.integers);
+        booleans_.resize(booleans_.size() + count.booleans);
+        strings_.resize(strings_.size() + count.strings);
+        int64s_.resize(int64s_.size() + count.int64s);
+        uint64s_.resize(uint64s_.size() + count.uint64s);
+        float32s_.resize(float32s_.size() + count.float32s);
+
+        return slice;
+    }
+
+    void clear()
+    {
+        reals_.clear();
+        integers_.clear();
+        booleans_.clear();
+        strings_.clear();
+        int64s_.clear();
+        uint64s_.clear();
+        float32s_.clear();
+    }
+
+    [[nodiscard]] std::span<double> reals() { return reals_; }
+    [[nodiscard]] std::span<int32_t> integers() { return integers_; }
+    [[nodiscard]] std::span<uint8_t> booleans() { return booleans_; }
+    [[nodiscard]] std::span<std::string> strings() { return strings_; }
+    [[nodiscard]] std::span<int64_t> int64s() { return int64s_; }
+    [[nodiscard]] std::span<uint64_t> uint64s() { return uint64s_; }
+    [[nodiscard]] std::span<float> float32s() { return float32s_; }
+
+    [[nodiscard]] std::span<const double> reals() const { return reals_; }
+    [[nodiscard]] std::span<const int32_t> integers() const { return integers_; }
+    [[nodiscard]] std::span<const uint8_t> booleans() const { return booleans_; }
+    [[nodiscard]] std::span<const std::string> strings() const { return strings_; }
+    [[nodiscard]] std::span<const int64_t> int64s() const { return int64s_; }
+    [[nodiscard]] std::span<const uint64_t> uint64s() const { return uint64s_; }
+    [[nodiscard]] std::span<const float> float32s() const { return float32s_; }
+
+    [[nodiscard]] std::span<double> reals(const value_slice& slice)
+    {
+        return reals().subspan(slice.realOffset, slice.count.reals);
+    }
+
+    [[nodiscard]] std::span<int32_t> integers(const value_slice& slice)
+    {
+        return integers().subspan(slice.integerOffset, slice.count.integers);
+    }
+
+    [[nodiscard]] std::span<uint8_t> booleans(const value_slice& slice)
+    {
+        return booleans().subspan(slice.booleanOffset, slice.count.booleans);
+    }
+
+    [[nodiscard]] std::span<std::string> strings(const value_slice& slice)
+    {
+        return strings().subspan(slice.stringOffset, slice.count.strings);
+    }
+
+    [[nodiscard]] std::span<int64_t> int64s(const value_slice& slice)
+    {
+        return int64s().subspan(slice.int64Offset, slice.count.int64s);
+    }
+
+    [[nodiscard]] std::span<uint64_t> uint64s(const value_slice& slice)
+    {
+        return uint64s().subspan(slice.uint64Offset, slice.count.uint64s);
+    }
+
+    [[nodiscard]] std::span<float> float32s(const value_slice& slice)
+    {
+        return float32s().subspan(slice.float32Offset, slice.count.float32s);
+    }
+
+private:
+    std::vector<double> reals_;
+    std::vector<int32_t> integers_;
+    std::vector<uint8_t> booleans_;
+    std::vector<std::string> strings_;
+    std::vector<int64_t> int64s_;
+    std::vector<uint64_t> uint64s_;
+    std::vector<float> float32s_;
+};
+
+} // namespace ecos
+
+#endif // ECOS_VALUE_STORE_HPP
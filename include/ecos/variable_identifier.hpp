@@ -2,11 +2,13 @@
 #ifndef ECOS_VARIABLE_IDENTIFIER_HPP
 #define ECOS_VARIABLE_IDENTIFIER_HPP
 
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
-#include <utility>
 
 namespace ecos
 {
@@ -15,8 +17,11 @@ namespace ecos
  * \brief Represents a variable identifier in the format "instanceName::variableName".
  *
  * A variable_identifier is used to uniquely identify a variable within a simulation.
+ * Instance and variable names are interned, such that an identifier is a pair of compact integer ids
+ * which are cheap to copy, compare and hash. Interned names live for the duration of the program,
+ * and there is no limit on their number other than the 2^32 ids available.
  */
-struct variable_identifier : std::pair<std::string, std::string>
+struct variable_identifier
 {
 
     // Constructs a variable_identifier from a string in the format "instanceName::variableName".
@@ -24,16 +29,23 @@ struct variable_identifier : std::pair<std::string, std::string>
         : variable_identifier(parse(identifier))
     { }
 
-    variable_identifier(std::string instanceName, std::string variableName)
-        : std::pair<std::string, std::string>(std::move(instanceName), std::move(variableName))
+    variable_identifier(std::string_view instanceName, std::string_view variableName)
+        : instance_(intern(instanceName))
+        , variable_(intern(variableName))
     { }
 
-    [[nodiscard]] const std::string& instance_name() const { return first; }
-    [[nodiscard]] const std::string& variable_name() const { return second; }
+    [[nodiscard]] const std::string& instance_name() const { return name(instance_); }
+    [[nodiscard]] const std::string& variable_name() const { return name(variable_); }
+
+    // Unique key of this identifier, combining the interned instance and variable names.
+    [[nodiscard]] uint64_t key() const
+    {
+        return static_cast<uint64_t>(instance_) << 32 | variable_;
+    }
 
     [[nodiscard]] std::string str() const
     {
-        return first + "::" + second;
+        return instance_name() + "::" + variable_name();
     }
 
     [[nodiscard]] bool matches(const variable_identifier& pattern) const
@@ -42,17 +54,47 @@ struct variable_identifier : std::pair<std::string, std::string>
             wildcard_match(variable_name(), pattern.variable_name());
     }
 
+    // Access as (instanceName, variableName), enabling structured bindings.
+    template<size_t I>
+    [[nodiscard]] const std::string& get() const
+    {
+        static_assert(I < 2);
+        return I == 0 ? instance_name() : variable_name();
+    }
+
+    friend bool operator==(const variable_identifier& lhs, const variable_identifier& rhs)
+    {
+        return lhs.key() == rhs.key();
+    }
+
+    // Lexicographic ordering by instance name, then variable name.
+    friend bool operator<(const variable_identifier& lhs, const variable_identifier& rhs)
+    {
+        if (lhs.instance_ != rhs.instance_) return lhs.instance_name() < rhs.instance_name();
+        if (lhs.variable_ != rhs.variable_) return lhs.variable_name() < rhs.variable_name();
+        return false;
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const variable_identifier& v)
     {
-        os << v.str();
+        os << v.instance_name() << "::" << v.variable_name();
         return os;
     }
 
 private:
-    static variable_identifier parse(const std::string& identifier)
+    uint32_t instance_;
+    uint32_t variable_;
+
+    // Returns the id of a name, adding it to the table of interned names if not already present.
+    static uint32_t intern(std::string_view name);
+
+    // Returns the interned name of an id.
+    static const std::string& name(uint32_t id);
+
+    static variable_identifier parse(std::string_view identifier)
     {
         const auto pos = identifier.find("::");
-        if (pos == std::string::npos) {
+        if (pos == std::string_view::npos) {
             throw std::runtime_error("Error parsing variable identifier. A '::' must be present!");
         }
 
@@ -86,4 +128,23 @@ private:
 
 } // namespace ecos
 
+template<>
+struct std::hash<ecos::variable_identifier>
+{
+    size_t operator()(const ecos::variable_identifier& id) const noexcept
+    {
+        return std::hash<uint64_t>{}(id.key());
+    }
+};
+
+template<>
+struct std::tuple_size<ecos::variable_identifier> : std::integral_constant<size_t, 2>
+{ };
+
+template<size_t I>
+struct std::tuple_element<I, ecos::variable_identifier>
+{
+    using type = const std::string;
+};
+
 #endif // ECOS_VARIABLE_IDENTIFIER_HPP
@@ -0,0 +1,303 @@
+#include "ecos/algorithm/adaptive_step_algorithm.hpp"
+
+#include "ecos/logger/logger.hpp"
+#include "ecos/util/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+using namespace ecos;
+
+namespace
+{
+
+// Step size controller, the coupling error of a macro step with inputs held constant is of order h^2
+constexpr double safety = 0.9;
+constexpr double minFactor = 0.2;
+constexpr double maxFactor = 2.0;
+
+} // namespace
+
+class adaptive_step_algorithm::impl
+{
+
+public:
+    impl(double initialStepSize, double minStepSize, double maxStepSize, double tolerance, bool parallel)
+        : parallel_(parallel)
+        , stepSize_(initialStepSize)
+        , minStepSize_(minStepSize)
+        , maxStepSize_(maxStepSize)
+        , tolerance_(tolerance)
+    {
+        if (minStepSize <= 0 || minStepSize > maxStepSize) {
+            throw std::invalid_argument("Expected 0 < minStepSize <= maxStepSize");
+        }
+        if (initialStepSize < minStepSize || initialStepSize > maxStepSize) {
+            throw std::invalid_argument("initialStepSize must be within [minStepSize, maxStepSize]");
+        }
+        if (tolerance <= 0) {
+            throw std::invalid_argument("tolerance must be greater than 0");
+        }
+    }
+
+    void model_instance_added(model_instance* instance)
+    {
+        instances_.emplace_back(instance);
+        outputsOutdated_ = true;
+    }
+
+    void connection_added(connection* c)
+    {
+        connections_.emplace_back(c);
+        outputsOutdated_ = true;
+    }
+
+    void set_thread_pool(thread_pool* pool)
+    {
+        pool_ = pool;
+    }
+
+    [[nodiscard]] double step_size() const
+    {
+        return stepSize_;
+    }
+
+    double step(double currentTime)
+    {
+        if (outputsOutdated_) {
+            collect_outputs();
+            outputsOutdated_ = false;
+        }
+
+        if (!rollback_) {
+            for_each_instance([&](model_instance& instance) {
+                auto& properties = instance.get_properties();
+                properties.apply_sets();
+                instance.step(currentTime, stepSize_);
+                properties.apply_gets();
+            });
+            return currentTime + stepSize_;
+        }
+
+        // inputs transferred after the previous step are part of the saved state
+        for_each_instance([](model_instance& instance) {
+            instance.get_properties().apply_sets();
+        });
+        std::vector<std::unique_ptr<model_state>> states(instances_.size());
+        for_each_index([&](size_t i) {
+            states[i] = instances_[i]->get_state();
+        });
+        // deadbands are applied relative to the last value propagated, which is rolled back along with the sinks
+        for (size_t i = 0; i < deadbands_.size(); ++i) {
+            references_[i] = deadbands_[i]->deadband_reference();
+        }
+
+        while (true) {
+            const double h = stepSize_;
+
+            for_each_instance([&](model_instance& instance) {
+                instance.step(currentTime, h);
+                instance.get_properties().apply_gets();
+            });
+            capture(full_);
+
+            restore(states);
+            for_each_instance([&](model_instance& instance) {
+                instance.step(currentTime, h / 2);
+                instance.get_properties().apply_gets();
+            });
+            for (const auto c : connections_) {
+                c->transferData();
+            }
+            for_each_instance([&](model_instance& instance) {
+                auto& properties = instance.get_properties();
+                properties.apply_sets();
+                instance.step(currentTime + h / 2, h / 2);
+                properties.apply_gets();
+            });
+            capture(half_);
+
+            const double error = estimate_error();
+            const double factor = error > 0 ? std::clamp(safety / std::sqrt(error), minFactor, maxFactor) : maxFactor;
+
+            if (error <= 1 || h <= minStepSize_) {
+                if (error > 1) {
+                    ++numForced_;
+                    log::debug("Accepting step at t={} with error {:.3g} at the minimum step size", currentTime, error);
+                }
+                ++numAccepted_;
+                smallestStep_ = std::min(smallestStep_, h);
+                largestStep_ = std::max(largestStep_, h);
+                stepSize_ = std::clamp(h * factor, minStepSize_, maxStepSize_);
+                // the state after two half steps is kept, being the more accurate one
+                return currentTime + h;
+            }
+
+            ++numRejected_;
+            stepSize_ = std::max(minStepSize_, h * factor);
+            log::trace("Rejected step of {} at t={} with error {:.3g}, retrying with {}", h, currentTime, error, stepSize_);
+            restore(states);
+        }
+    }
+
+    void terminate()
+    {
+        if (numAccepted_ == 0) return;
+
+        log::info("Adaptive step: {} steps accepted ({} at the minimum step size), {} rejected, step size within [{}, {}]",
+            numAccepted_, numForced_, numRejected_, smallestStep_, largestStep_);
+    }
+
+private:
+    bool parallel_;
+    double stepSize_;
+    double minStepSize_;
+    double maxStepSize_;
+    double tolerance_;
+    thread_pool* pool_{nullptr};
+
+    std::vector<model_instance*> instances_;
+    std::vector<connection*> connections_;
+
+    bool outputsOutdated_{true};
+    bool rollback_{false};
+    std::vector<const property_t<double>*> outputs_; // connected real outputs, used to estimate the error
+    std::vector<double> full_;
+    std::vector<double> half_;
+    std::vector<real_connection*> deadbands_; // connections whose deadband is rolled back on rejection
+    std::vector<std::optional<double>> references_; // their deadband references at the start of the step
+
+    size_t numAccepted_{0};
+    size_t numRejected_{0};
+    size_t numForced_{0};
+    double smallestStep_{INFINITY};
+    double largestStep_{0};
+
+    void for_each_index(const std::function<void(size_t)>& f)
+    {
+        if (!parallel_) {
+            for (size_t i = 0; i < instances_.size(); ++i) {
+                f(i);
+            }
+        } else if (pool_) {
+            pool_->parallel_for(instances_.size(), f);
+        } else {
+            std::vector<size_t> indices(instances_.size());
+            std::iota(indices.begin(), indices.end(), 0);
+            std::for_each(std::execution::par, indices.begin(), indices.end(), f);
+        }
+    }
+
+    void for_each_instance(const std::function<void(model_instance&)>& f)
+    {
+        for_each_index([&](size_t i) {
+            f(*instances_[i]);
+        });
+    }
+
+    void restore(std::vector<std::unique_ptr<model_state>>& states)
+    {
+        for_each_index([&](size_t i) {
+            instances_[i]->set_state(*states[i]);
+        });
+        for (size_t i = 0; i < deadbands_.size(); ++i) {
+            deadbands_[i]->set_deadband_reference(references_[i]);
+        }
+    }
+
+    void collect_outputs()
+    {
+        outputs_.clear();
+        std::unordered_set<const property*> seen;
+        for (const auto c : connections_) {
+            const auto source = dynamic_cast<const property_t<double>*>(c->source_property());
+            if (source && seen.emplace(source).second) {
+                outputs_.emplace_back(source);
+            }
+        }
+        full_.resize(outputs_.size());
+        half_.resize(outputs_.size());
+
+        deadbands_.clear();
+        for (const auto c : connections_) {
+            if (const auto rc = dynamic_cast<real_connection*>(c); rc && rc->deadband() > 0) {
+                deadbands_.emplace_back(rc);
+            }
+        }
+        references_.resize(deadbands_.size());
+
+        rollback_ = std::ranges::all_of(instances_, [](const model_instance* instance) {
+            return instance->can_get_and_set_state();
+        });
+        if (!rollback_) {
+            log::warn("Not all model instances support get/set state, the adaptive step algorithm will use a fixed step size of {}", stepSize_);
+        }
+    }
+
+    void capture(std::vector<double>& values) const
+    {
+        for (size_t i = 0; i < outputs_.size(); ++i) {
+            values[i] = outputs_[i]->get_value();
+        }
+    }
+
+    [[nodiscard]] double estimate_error() const
+    {
+        double error = 0;
+        for (size_t i = 0; i < outputs_.size(); ++i) {
+            const double scale = tolerance_ * (1 + std::abs(half_[i]));
+            error = std::max(error, std::abs(full_[i] - half_[i]) / scale);
+        }
+        // non-finite values always call for a smaller step
+        return std::isfinite(error) ? error : INFINITY;
+    }
+};
+
+
+adaptive_step_algorithm::adaptive_step_algorithm(double initialStepSize, double minStepSize, double maxStepSize, double tolerance, bool parallel)
+    : pimpl_(std::make_unique<impl>(initialStepSize, minStepSize, maxStepSize, tolerance, parallel))
+{ }
+
+void adaptive_step_algorithm::model_instance_added(model_instance* instance)
+{
+    pimpl_->model_instance_added(instance);
+}
+
+void adaptive_step_algorithm::connection_added(connection* c)
+{
+    pimpl_->connection_added(c);
+}
+
+double adaptive_step_algorithm::step(double currentTime)
+{
+    return pimpl_->step(currentTime);
+}
+
+bool adaptive_step_algorithm::updates_all_instances() const
+{
+    return true;
+}
+
+void adaptive_step_algorithm::set_thread_pool(thread_pool* pool)
+{
+    pimpl_->set_thread_pool(pool);
+}
+
+void adaptive_step_algorithm::terminate()
+{
+    pimpl_->terminate();
+}
+
+double adaptive_step_algorithm::step_size() const
+{
+    return pimpl_->step_size();
+}
+
+adaptive_step_algorithm::~adaptive_step_algorithm() = default;
@@ -0,0 +1,493 @@
+#include "ecos/algorithm/dataflow_algorithm.hpp"
+
+#include "decimation_factor.hpp"
+
+#include "ecos/logger/logger.hpp"
+#include "ecos/util/thread_pool.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+using namespace ecos;
+
+namespace
+{
+
+struct instance_wrapper
+{
+    int decimationFactor;
+    model_instance* instance;
+};
+
+// Input of an instance, fed from a connected source
+template<class T>
+struct input_link
+{
+    uint32_t source;
+    property_t<T>* sink;
+    real_connection* filtered; // connection with a modifier and/or deadband
+};
+
+// Connections of a single type. Values of each source are kept in a ring buffer holding one version per tick in flight.
+template<class T>
+struct channel
+{
+    // avoids std::vector<bool>, so that different sources may be written concurrently
+    using storage_type = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+    std::vector<property_t<T>*> sources;
+    std::vector<storage_type> ring; // ring[slot * sources.size() + source]
+
+    std::vector<std::vector<uint32_t>> captures;        // sources owned by each instance
+    std::vector<std::vector<input_link<T>>> inputs; // inputs of each instance
+
+    // only used while compiling
+    std::unordered_map<property_t<T>*, uint32_t> sourceIndex;
+
+    void reset(size_t numInstances)
+    {
+        sources.clear();
+        ring.clear();
+        sourceIndex.clear();
+        captures.assign(numInstances, {});
+        inputs.assign(numInstances, {});
+    }
+
+    void add(property_t<T>* source, size_t sourceOwner, property_t<T>* sink, size_t sinkOwner, real_connection* filtered)
+    {
+        auto it = sourceIndex.find(source);
+        if (it == sourceIndex.end()) {
+            it = sourceIndex.emplace(source, static_cast<uint32_t>(sources.size())).first;
+            sources.emplace_back(source);
+            captures[sourceOwner].emplace_back(it->second);
+        }
+        inputs[sinkOwner].emplace_back(input_link<T>{it->second, sink, filtered});
+    }
+
+    void allocate(size_t depth)
+    {
+        ring.assign(depth * sources.size(), storage_type{});
+        sourceIndex.clear();
+    }
+
+    void capture(size_t instance, size_t slot)
+    {
+        const size_t offset = slot * sources.size();
+        for (const auto s : captures[instance]) {
+            ring[offset + s] = sources[s]->get_value();
+        }
+    }
+
+    void gather(size_t instance, size_t slot)
+    {
+        const size_t offset = slot * sources.size();
+        for (const auto& link : inputs[instance]) {
+            T value = static_cast<T>(ring[offset + link.source]);
+            if constexpr (std::is_same_v<T, double>) {
+                if (const auto c = link.filtered) {
+                    if (c->modifier) {
+                        value = c->modifier.value()(value);
+                    }
+                    if (!c->accept(value)) continue;
+                }
+            }
+            link.sink->set_value(value);
+        }
+    }
+};
+
+void add_unique(std::vector<size_t>& v, size_t value)
+{
+    if (std::ranges::find(v, value) == v.end()) {
+        v.emplace_back(value);
+    }
+}
+
+} // namespace
+
+class dataflow_algorithm::impl
+{
+
+public:
+    impl(double stepSize, unsigned window, unsigned maxRunAhead)
+        : stepSize_(stepSize)
+        , window_(window)
+        , maxRunAhead_(maxRunAhead)
+    {
+        if (stepSize <= 0) {
+            throw std::invalid_argument("stepSize must be greater than 0");
+        }
+        if (window == 0) {
+            throw std::invalid_argument("window must be at least 1");
+        }
+        if (maxRunAhead == 0) {
+            throw std::invalid_argument("maxRunAhead must be at least 1");
+        }
+    }
+
+    void model_instance_added(model_instance* instance)
+    {
+        const int decimationFactor = calculateDecimationFactor(*instance, stepSize_);
+        instances_.emplace_back(instance_wrapper{decimationFactor, instance});
+        graphOutdated_ = true;
+    }
+
+    void connection_added(connection* c)
+    {
+        connections_.emplace_back(c);
+        graphOutdated_ = true;
+    }
+
+    void set_thread_pool(thread_pool* pool)
+    {
+        pool_ = pool;
+    }
+
+    double step(double currentTime)
+    {
+        if (graphOutdated_) {
+            compile();
+            graphOutdated_ = false;
+        }
+
+        times_.resize(ticks_);
+        times_[0] = currentTime;
+        for (size_t t = 1; t < ticks_; ++t) {
+            times_[t] = times_[t - 1] + stepSize_;
+        }
+
+        const size_t numTasks = ticks_ * instances_.size();
+        pending_.assign(dependencies_.begin(), dependencies_.begin() + static_cast<std::ptrdiff_t>(numTasks));
+        remaining_ = numTasks;
+        error_ = nullptr;
+        for (size_t task = 0; task < numTasks; ++task) {
+            if (pending_[task] == 0) {
+                ready_.push(task);
+            }
+        }
+
+        if (pool_ && pool_->num_threads() > 1) {
+            pool_->parallel_for(pool_->num_threads(), [this](size_t) {
+                work();
+            });
+        } else {
+            work();
+        }
+
+        if (error_) {
+            ready_ = {};
+            std::rethrow_exception(error_);
+        }
+
+        stepNumber_ += ticks_;
+
+        nextConsumers_.clear();
+        for (size_t i = 0; i < instances_.size(); ++i) {
+            if (should_step(stepNumber_, instances_[i].decimationFactor)) {
+                nextConsumers_.emplace_back(i);
+            }
+        }
+
+        return times_.back() + stepSize_;
+    }
+
+    [[nodiscard]] const std::vector<size_t>* pending_consumers() const
+    {
+        return graphOutdated_ ? nullptr : &nextConsumers_;
+    }
+
+private:
+    double stepSize_;
+    size_t window_;
+    size_t maxRunAhead_;
+    size_t stepNumber_{0};
+    thread_pool* pool_{nullptr};
+
+    std::vector<instance_wrapper> instances_;
+    std::vector<connection*> connections_;
+
+    // compiled from the connections
+    bool graphOutdated_{true};
+    size_t ticks_{1};
+    size_t depth_{1};
+    std::vector<std::vector<size_t>> upstream_;  // instances providing inputs to each instance
+    std::vector<std::vector<size_t>> consumers_; // instances consuming outputs of each instance
+    std::vector<unsigned> dependencies_;          // initial dependency count of each task
+    std::vector<size_t> nextConsumers_;           // instances due for a step at the start of the next window
+
+    channel<double> reals_;
+    channel<int> integers_;
+    channel<bool> booleans_;
+    channel<std::string> strings_;
+    channel<int64_t> int64s_;
+    channel<uint64_t> uint64s_;
+    channel<float> float32s_;
+
+    // task (instance i, tick t) has index t * numInstances + i, so lower indices are older ticks
+    std::vector<double> times_;
+    std::vector<unsigned> pending_;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<>> ready_;
+    size_t remaining_{0};
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    static bool should_step(size_t step, int factor)
+    {
+        return step % factor == 0;
+    }
+
+    void compile()
+    {
+        const size_t numInstances = instances_.size();
+
+        std::unordered_map<std::string, size_t> instanceIndex;
+        for (size_t i = 0; i < numInstances; ++i) {
+            instanceIndex.emplace(instances_[i].instance->instanceName(), i);
+        }
+
+        reals_.reset(numInstances);
+        integers_.reset(numInstances);
+        booleans_.reset(numInstances);
+        strings_.reset(numInstances);
+        int64s_.reset(numInstances);
+        uint64s_.reset(numInstances);
+        float32s_.reset(numInstances);
+        upstream_.assign(numInstances, {});
+        consumers_.assign(numInstances, {});
+
+        size_t numUnsupported = 0;
+        for (const auto c : connections_) {
+            const auto source = c->source_property();
+            const auto sink = c->sink_property();
+            const auto sourceIt = source ? instanceIndex.find(source->id().instance_name()) : instanceIndex.end();
+            const auto sinkIt = sink ? instanceIndex.find(sink->id().instance_name()) : instanceIndex.end();
+            if (sourceIt == instanceIndex.end() || sinkIt == instanceIndex.end()) {
+                ++numUnsupported;
+                continue;
+            }
+            const size_t from = sourceIt->second;
+            const size_t to = sinkIt->second;
+
+            const auto& type = typeid(*c);
+            if (type == typeid(real_connection)) {
+                const auto rc = static_cast<real_connection*>(c);
+                const bool filtered = rc->modifier || rc->deadband() > 0;
+                reals_.add(rc->source, from, rc->sink, to, filtered ? rc : nullptr);
+            } else if (type == typeid(int_connection)) {
+                const auto ic = static_cast<int_connection*>(c);
+                integers_.add(ic->source, from, ic->sink, to, nullptr);
+            } else if (type == typeid(bool_connection)) {
+                const auto bc = static_cast<bool_connection*>(c);
+                booleans_.add(bc->source, from, bc->sink, to, nullptr);
+            } else if (type == typeid(string_connection)) {
+                const auto sc = static_cast<string_connection*>(c);
+                strings_.add(sc->source, from, sc->sink, to, nullptr);
+            } else if (type == typeid(int64_connection)) {
+                const auto ic = static_cast<int64_connection*>(c);
+                int64s_.add(ic->source, from, ic->sink, to, nullptr);
+            } else if (type == typeid(uint64_connection)) {
+                const auto uc = static_cast<uint64_connection*>(c);
+                uint64s_.add(uc->source, from, uc->sink, to, nullptr);
+            } else if (type == typeid(float32_connection)) {
+                const auto fc = static_cast<float32_connection*>(c);
+                float32s_.add(fc->source, from, fc->sink, to, nullptr);
+            } else {
+                ++numUnsupported;
+                continue;
+            }
+
+            if (from != to) {
+                add_unique(upstream_[to], from);
+                add_unique(consumers_[from], to);
+            }
+        }
+
+        ticks_ = window_;
+        if (numUnsupported > 0 && window_ > 1) {
+            log::warn("{} connections can not be exchanged within a window, the dataflow window is reduced to a single step", numUnsupported);
+            ticks_ = 1;
+        }
+
+        // the producer of tick t writes slot t % depth, which was last read by its consumers at tick t - maxRunAhead
+        depth_ = std::min(maxRunAhead_, ticks_) + 1;
+        reals_.allocate(depth_);
+        integers_.allocate(depth_);
+        booleans_.allocate(depth_);
+        strings_.allocate(depth_);
+        int64s_.allocate(depth_);
+        uint64s_.allocate(depth_);
+        float32s_.allocate(depth_);
+
+        dependencies_.assign(ticks_ * numInstances, 0);
+        for (size_t t = 0; t < ticks_; ++t) {
+            for (size_t i = 0; i < numInstances; ++i) {
+                unsigned count = 0;
+                if (t > 0) {
+                    count += 1 + static_cast<unsigned>(upstream_[i].size());
+                }
+                if (t >= depth_ - 1) {
+                    count += static_cast<unsigned>(consumers_[i].size());
+                }
+                dependencies_[t * numInstances + i] = count;
+            }
+        }
+
+        log::debug("Dataflow graph of {} instances and {} connections, window of {} steps with a run-ahead of up to {} steps",
+            numInstances, connections_.size(), ticks_, depth_ - 1);
+    }
+
+    void run_task(size_t i, size_t t)
+    {
+        // instances not due for a step are left untouched, but still provide their outputs for the tick
+        auto& wrapper = instances_[i];
+        if (should_step(stepNumber_ + t, wrapper.decimationFactor)) {
+            if (t > 0) {
+                const size_t slot = (t - 1) % depth_;
+                reals_.gather(i, slot);
+                integers_.gather(i, slot);
+                booleans_.gather(i, slot);
+                strings_.gather(i, slot);
+                int64s_.gather(i, slot);
+                uint64s_.gather(i, slot);
+                float32s_.gather(i, slot);
+            }
+
+            auto& properties = wrapper.instance->get_properties();
+            properties.apply_sets();
+            wrapper.instance->step(times_[t], stepSize_ * wrapper.decimationFactor);
+            properties.apply_gets();
+        }
+
+        // outputs of the last tick are transferred by the simulation
+        if (t + 1 < ticks_) {
+            const size_t slot = t % depth_;
+            reals_.capture(i, slot);
+            integers_.capture(i, slot);
+            booleans_.capture(i, slot);
+            strings_.capture(i, slot);
+            int64s_.capture(i, slot);
+            uint64s_.capture(i, slot);
+            float32s_.capture(i, slot);
+        }
+    }
+
+    // Marks the task as completed, returns the number of tasks which became ready. Requires the lock.
+    size_t release(size_t task)
+    {
+        const size_t numInstances = instances_.size();
+        const size_t i = task % numInstances;
+        const size_t t = task / numInstances;
+
+        size_t released = 0;
+        auto decrement = [&](size_t instance, size_t tick) {
+            const size_t successor = tick * numInstances + instance;
+            if (--pending_[successor] == 0) {
+                ready_.push(successor);
+                ++released;
+            }
+        };
+
+        if (t + 1 < ticks_) {
+            decrement(i, t + 1);
+            for (const auto c : consumers_[i]) {
+                decrement(c, t + 1);
+            }
+        }
+        if (const size_t tick = t + depth_ - 1; tick < ticks_) {
+            for (const auto j : upstream_[i]) {
+                decrement(j, tick);
+            }
+        }
+        return released;
+    }
+
+    void work()
+    {
+        const size_t numInstances = instances_.size();
+
+        std::unique_lock lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] {
+                return !ready_.empty() || remaining_ == 0 || error_;
+            });
+            if (remaining_ == 0 || error_) return;
+
+            const size_t task = ready_.top();
+            ready_.pop();
+            lock.unlock();
+
+            std::exception_ptr error;
+            try {
+                run_task(task % numInstances, task / numInstances);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (error) {
+                error_ = error;
+                cv_.notify_all();
+                return;
+            }
+
+            --remaining_;
+            const size_t released = release(task);
+            if (remaining_ == 0) {
+                cv_.notify_all();
+            } else {
+                // this thread picks up one of the released tasks itself
+                for (size_t k = 1; k < released; ++k) {
+                    cv_.notify_one();
+                }
+            }
+        }
+    }
+};
+
+
+dataflow_algorithm::dataflow_algorithm(double stepSize, unsigned window, unsigned maxRunAhead)
+    : pimpl_(std::make_unique<impl>(stepSize, window, maxRunAhead))
+{ }
+
+void dataflow_algorithm::model_instance_added(model_instance* instance)
+{
+    pimpl_->model_instance_added(instance);
+}
+
+void dataflow_algorithm::connection_added(connection* c)
+{
+    pimpl_->connection_added(c);
+}
+
+double dataflow_algorithm::step(double currentTime)
+{
+    return pimpl_->step(currentTime);
+}
+
+bool dataflow_algorithm::updates_all_instances() const
+{
+    return true;
+}
+
+const std::vector<size_t>* dataflow_algorithm::pending_consumers() const
+{
+    return pimpl_->pending_consumers();
+}
+
+void dataflow_algorithm::set_thread_pool(thread_pool* pool)
+{
+    pimpl_->set_thread_pool(pool);
+}
+
+dataflow_algorithm::~dataflow_algorithm() = default;
@@ -0,0 +1,34 @@
+#ifndef ECOS_DECIMATION_FACTOR_HPP
+#define ECOS_DECIMATION_FACTOR_HPP
+
+#include "ecos/logger/logger.hpp"
+#include "ecos/model_instance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ecos
+{
+
+// Number of base steps per step of the given model, derived from its step size hint.
+inline int calculateDecimationFactor(const model_instance& m, double baseStepSize)
+{
+
+    constexpr double EPS = 1e-3;
+
+    const auto& stepSizeHint = m.stepSizeHint();
+    if (!stepSizeHint) return 1;
+
+    const int decimationFactor = std::max(1, static_cast<int>(std::ceil(*stepSizeHint / baseStepSize)));
+    const double actualStepSize = baseStepSize * decimationFactor;
+    const double diff = std::fabs(actualStepSize - *stepSizeHint);
+    if (diff >= EPS) {
+        log::warn("Actual stepSize for {} will be {} rather than requested value {}", m.instanceName(), actualStepSize, *stepSizeHint);
+    }
+
+    return decimationFactor;
+}
+
+} // namespace ecos
+
+#endif // ECOS_DECIMATION_FACTOR_HPP
@@ -1,38 +1,85 @@
 
 #include "ecos/algorithm/fixed_step_algorithm.hpp"
 
+#include "decimation_factor.hpp"
+
 #include "ecos/logger/logger.hpp"
+#include "ecos/util/thread_pool.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <numeric>
 
 using namespace ecos;
 
 namespace
 {
 
+// Number of steps measured before instances are first distributed by cost, and between subsequent re-evaluations.
+constexpr size_t warmupSteps = 20;
+constexpr size_t rebalanceInterval = 500;
+// Instances are only re-distributed when it shortens the predicted step time by more than this factor.
+constexpr double rebalanceThreshold = 1.1;
+// Longest hyperperiod (in base steps) kept as a schedule table.
+constexpr size_t maxScheduleLength = 4096;
+
 struct instance_wrapper
 {
     int decimationFactor;
     model_instance* instance;
+    double windowTime{0}; // wall time spent within the current measurement window
 };
 
-int calculateDecimationFactor(const model_instance& m, double baseStepSize)
+struct alignas(64) thread_usage
 {
+    double busyTime{0};
+    size_t numTasks{0};
+};
 
-    constexpr double EPS = 1e-3;
+// Thread of each instance when split into contiguous, equally sized chunks (the default distribution of thread_pool).
+std::vector<size_t> even_assignment(size_t numInstances, size_t numThreads)
+{
+    std::vector<size_t> assignment(numInstances);
+    const size_t chunk = numInstances / numThreads;
+    const size_t remainder = numInstances % numThreads;
+    size_t i = 0;
+    for (size_t t = 0; t < numThreads; ++t) {
+        const size_t size = chunk + (t < remainder ? 1 : 0);
+        for (size_t j = 0; j < size; ++j) {
+            assignment[i++] = t;
+        }
+    }
+    return assignment;
+}
 
-    const auto& stepSizeHint = m.stepSizeHint();
-    if (!stepSizeHint) return 1;
+// Longest processing time first: the most expensive remaining instance goes to the least loaded thread.
+std::vector<size_t> lpt_assignment(const std::vector<double>& costs, size_t numThreads)
+{
+    std::vector<size_t> byCost(costs.size());
+    std::iota(byCost.begin(), byCost.end(), 0);
+    std::ranges::stable_sort(byCost, [&](size_t a, size_t b) {
+        return costs[a] > costs[b];
+    });
 
-    const int decimationFactor = std::max(1, static_cast<int>(std::ceil(*stepSizeHint / baseStepSize)));
-    const double actualStepSize = baseStepSize * decimationFactor;
-    const double diff = std::fabs(actualStepSize - *stepSizeHint);
-    if (diff >= EPS) {
-        log::warn("Actual stepSize for {} will be {} rather than requested value {}", m.instanceName(), actualStepSize, *stepSizeHint);
+    std::vector<size_t> assignment(costs.size());
+    std::vector<double> loads(numThreads);
+    for (const auto i : byCost) {
+        const auto t = static_cast<size_t>(std::distance(loads.begin(), std::ranges::min_element(loads)));
+        assignment[i] = t;
+        loads[t] += costs[i];
     }
+    return assignment;
+}
 
-    return decimationFactor;
+// Predicted duration of a step, i.e. the load of the busiest thread.
+double makespan(const std::vector<double>& costs, const std::vector<size_t>& assignment, size_t numThreads)
+{
+    std::vector<double> loads(numThreads);
+    for (size_t i = 0; i < costs.size(); ++i) {
+        loads[assignment[i]] += costs[i];
+    }
+    return *std::ranges::max_element(loads);
 }
 
 } // namespace
@@ -51,22 +98,68 @@ public:
     {
         const int decimationFactor = calculateDecimationFactor(*instance, stepSize_);
         instances_.emplace_back(instance_wrapper{decimationFactor, instance});
+        reset_partitioning();
+    }
+
+    void set_thread_pool(thread_pool* pool)
+    {
+        pool_ = pool;
+        usage_.assign(pool_ ? pool_->num_threads() : 0, thread_usage{});
+        parallelTime_ = 0;
+        reset_partitioning();
     }
 
     double step(double currentTime)
     {
-        auto f = [currentTime, this](auto& wrapper) {
-            if (should_step(stepNumber_, wrapper.decimationFactor)) {
-                wrapper.instance->get_properties().apply_sets();
-                wrapper.instance->step(currentTime, stepSize_ * wrapper.decimationFactor);
-                wrapper.instance->get_properties().apply_gets();
+        if (scheduleOutdated_) {
+            build_schedule();
+        }
+        const auto& tick = current_tick();
+
+        const bool measure = parallel_ && pool_ && pool_->num_threads() > 1;
+
+        auto f = [currentTime, measure, this](auto& wrapper) {
+            const auto start = measure ? clock::now() : clock::time_point{};
+
+            auto& properties = wrapper.instance->get_properties();
+            properties.apply_sets();
+            wrapper.instance->step(currentTime, stepSize_ * wrapper.decimationFactor);
+            properties.apply_gets();
+
+            if (measure) {
+                const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+                wrapper.windowTime += elapsed;
+                auto& usage = usage_[thread_pool::current_thread_index()];
+                usage.busyTime += elapsed;
+                ++usage.numTasks;
             }
         };
 
         if (!parallel_) {
-            std::ranges::for_each(instances_, f);
+            for (const auto i : tick.order) {
+                f(instances_[i]);
+            }
+        } else if (pool_) {
+            const auto start = clock::now();
+            if (tick.offsets.empty()) {
+                pool_->parallel_for(tick.order.size(), [&](size_t k) {
+                    f(instances_[tick.order[k]]);
+                });
+            } else {
+                pool_->parallel_for(tick.offsets, [&](size_t k) {
+                    f(instances_[tick.order[k]]);
+                });
+            }
+            if (measure) {
+                parallelTime_ += std::chrono::duration<double>(clock::now() - start).count();
+                if (++windowSteps_ == (assignment_.empty() ? warmupSteps : rebalanceInterval)) {
+                    rebalance();
+                }
+            }
         } else {
-            std::for_each(std::execution::par, instances_.begin(), instances_.end(), f);
+            std::for_each(std::execution::par, tick.order.begin(), tick.order.end(), [&](size_t i) {
+                f(instances_[i]);
+            });
         }
 
         ++stepNumber_;
@@ -74,17 +167,159 @@ public:
         return currentTime + stepSize_;
     }
 
+    const std::vector<size_t>* pending_consumers()
+    {
+        if (scheduleOutdated_) {
+            build_schedule();
+        }
+        return &current_tick().consumers;
+    }
+
+    void terminate()
+    {
+        if (parallelTime_ <= 0) return;
+
+        for (size_t t = 0; t < usage_.size(); ++t) {
+            log::info("Thread {}: {:.1f}% utilised ({} instance updates)",
+                t, 100 * usage_[t].busyTime / parallelTime_, usage_[t].numTasks);
+        }
+    }
+
     ~impl() = default;
 
 private:
+    using clock = std::chrono::steady_clock;
+
+    // Work of a single base step
+    struct tick
+    {
+        std::vector<size_t> order;     // instances stepping at this tick, grouped by thread when distributed by cost
+        std::vector<size_t> offsets;   // start of each thread's group within order, plus end. Empty when not distributed
+        std::vector<size_t> consumers; // instances reading their inputs at this tick, in order of addition
+    };
+
     bool parallel_;
     double stepSize_;
     size_t stepNumber_;
     std::vector<instance_wrapper> instances_;
+    thread_pool* pool_{nullptr};
+
+    // cost based distribution of instances over threads, empty until the warm-up has completed
+    std::vector<size_t> assignment_; // thread of each instance
+
+    // one tick per base step of the hyperperiod, i.e. the least common multiple of all decimation factors.
+    // Longer hyperperiods are not tabulated, their ticks are built on demand instead.
+    bool scheduleOutdated_{true};
+    size_t hyperperiod_{1};
+    std::vector<tick> schedule_;
+    tick scratch_;
+    size_t scratchTick_{SIZE_MAX};
+
+    size_t windowSteps_{0};
+    std::vector<thread_usage> usage_;
+    double parallelTime_{0};
+
+    void reset_partitioning()
+    {
+        assignment_.clear();
+        scheduleOutdated_ = true;
+        windowSteps_ = 0;
+        for (auto& wrapper : instances_) {
+            wrapper.windowTime = 0;
+        }
+    }
 
-    static bool should_step(size_t step, int factor)
+    const tick& current_tick()
     {
-        return step % factor == 0;
+        const size_t k = stepNumber_ % hyperperiod_;
+        if (!schedule_.empty()) {
+            return schedule_[k];
+        }
+        if (scratchTick_ != k) {
+            build_tick(k, scratch_);
+            scratchTick_ = k;
+        }
+        return scratch_;
+    }
+
+    void build_tick(size_t k, tick& tick) const
+    {
+        tick.order.clear();
+        tick.offsets.clear();
+        tick.consumers.clear();
+        for (size_t i = 0; i < instances_.size(); ++i) {
+            if (k % instances_[i].decimationFactor == 0) {
+                tick.consumers.emplace_back(i);
+            }
+        }
+
+        if (assignment_.empty()) {
+            tick.order = tick.consumers;
+            return;
+        }
+
+        const size_t numThreads = pool_->num_threads();
+        tick.offsets.assign(numThreads + 1, 0);
+        for (const auto i : tick.consumers) {
+            ++tick.offsets[assignment_[i] + 1];
+        }
+        for (size_t t = 0; t < numThreads; ++t) {
+            tick.offsets[t + 1] += tick.offsets[t];
+        }
+        tick.order.resize(tick.consumers.size());
+        std::vector<size_t> next(tick.offsets.begin(), tick.offsets.end() - 1);
+        for (const auto i : tick.consumers) {
+            tick.order[next[assignment_[i]]++] = i;
+        }
+    }
+
+    void build_schedule()
+    {
+        hyperperiod_ = 1;
+        for (const auto& wrapper : instances_) {
+            hyperperiod_ = std::lcm(hyperperiod_, static_cast<size_t>(wrapper.decimationFactor));
+            if (hyperperiod_ > maxScheduleLength) break;
+        }
+
+        schedule_.clear();
+        scratchTick_ = SIZE_MAX;
+        if (hyperperiod_ <= maxScheduleLength) {
+            schedule_.resize(hyperperiod_);
+            for (size_t k = 0; k < hyperperiod_; ++k) {
+                build_tick(k, schedule_[k]);
+            }
+            log::debug("Schedule of {} ticks for {} instances", hyperperiod_, instances_.size());
+        } else {
+            hyperperiod_ = SIZE_MAX;
+            log::debug("Hyperperiod of the decimation factors exceeds {} steps, ticks are built on demand", maxScheduleLength);
+        }
+        scheduleOutdated_ = false;
+    }
+
+    void rebalance()
+    {
+        const size_t numThreads = pool_->num_threads();
+
+        // average cost per step, which accounts for instances with a decimation factor
+        std::vector<double> costs;
+        costs.reserve(instances_.size());
+        for (auto& wrapper : instances_) {
+            costs.emplace_back(wrapper.windowTime / static_cast<double>(windowSteps_));
+            wrapper.windowTime = 0;
+        }
+        windowSteps_ = 0;
+
+        const auto current = assignment_.empty() ? even_assignment(instances_.size(), numThreads) : assignment_;
+        auto proposed = lpt_assignment(costs, numThreads);
+
+        const double currentMakespan = makespan(costs, current, numThreads);
+        const double proposedMakespan = makespan(costs, proposed, numThreads);
+        if (assignment_.empty() || currentMakespan > proposedMakespan * rebalanceThreshold) {
+            log::debug("Distributing {} instances over {} threads by cost, predicted step time {:.3f}ms -> {:.3f}ms",
+                instances_.size(), numThreads, currentMakespan * 1e3, proposedMakespan * 1e3);
+            assignment_ = std::move(proposed);
+            scheduleOutdated_ = true;
+        }
     }
 };
 
@@ -103,4 +338,24 @@ double fixed_step_algorithm::step(double currentTime)
     return pimpl_->step(currentTime);
 }
 
+bool fixed_step_algorithm::updates_all_instances() const
+{
+    return true;
+}
+
+const std::vector<size_t>* fixed_step_algorithm::pending_consumers() const
+{
+    return pimpl_->pending_consumers();
+}
+
+void fixed_step_algorithm::set_thread_pool(thread_pool* pool)
+{
+    pimpl_->set_thread_pool(pool);
+}
+
+void fixed_step_algorithm::terminate()
+{
+    pimpl_->terminate();
+}
+
 fixed_step_algorithm::~fixed_step_algorithm() = default;
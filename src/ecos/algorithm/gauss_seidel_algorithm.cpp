@@ -0,0 +1,302 @@
+#include "ecos/algorithm/gauss_seidel_algorithm.hpp"
+
+#include "decimation_factor.hpp"
+#include "util/graph.hpp"
+
+#include "ecos/logger/logger.hpp"
+#include "ecos/util/thread_pool.hpp"
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+using namespace ecos;
+
+namespace
+{
+
+struct instance_wrapper
+{
+    int decimationFactor;
+    model_instance* instance;
+    int priority{0};
+    std::vector<connection*> inputs; // connections transferred right before stepping
+};
+
+} // namespace
+
+class gauss_seidel_algorithm::impl
+{
+
+public:
+    impl(double stepSize, bool parallel)
+        : parallel_(parallel)
+        , stepSize_(stepSize)
+    { }
+
+    void set_priority(const std::string& instanceName, int priority)
+    {
+        priorities_[instanceName] = priority;
+        scheduleOutdated_ = true;
+    }
+
+    void delay_input(const variable_identifier& pattern)
+    {
+        delayedInputs_.emplace_back(pattern);
+        scheduleOutdated_ = true;
+    }
+
+    void model_instance_added(model_instance* instance)
+    {
+        const int decimationFactor = calculateDecimationFactor(*instance, stepSize_);
+        instances_.emplace_back(instance_wrapper{decimationFactor, instance});
+        scheduleOutdated_ = true;
+    }
+
+    void connection_added(connection* c)
+    {
+        connections_.emplace_back(c);
+        scheduleOutdated_ = true;
+    }
+
+    void set_thread_pool(thread_pool* pool)
+    {
+        pool_ = pool;
+    }
+
+    double step(double currentTime)
+    {
+        if (scheduleOutdated_) {
+            build_schedule();
+            scheduleOutdated_ = false;
+        }
+
+        auto f = [currentTime, this](instance_wrapper& wrapper) {
+            // values from instances in earlier stages of this step
+            for (const auto c : wrapper.inputs) {
+                c->transferData();
+            }
+
+            auto& properties = wrapper.instance->get_properties();
+            properties.apply_sets();
+            if (should_step(stepNumber_, wrapper.decimationFactor)) {
+                wrapper.instance->step(currentTime, stepSize_ * wrapper.decimationFactor);
+            }
+            properties.apply_gets();
+        };
+
+        for (auto& stage : stages_) {
+            if (!parallel_ || stage.size() == 1) {
+                for (const auto i : stage) {
+                    f(instances_[i]);
+                }
+            } else if (pool_) {
+                pool_->parallel_for(stage.size(), [&](size_t k) {
+                    f(instances_[stage[k]]);
+                });
+            } else {
+                std::for_each(std::execution::par, stage.begin(), stage.end(), [&](size_t i) {
+                    f(instances_[i]);
+                });
+            }
+        }
+
+        ++stepNumber_;
+
+        return currentTime + stepSize_;
+    }
+
+    [[nodiscard]] const std::vector<size_t>* pending_consumers() const
+    {
+        return &consumers_;
+    }
+
+private:
+    bool parallel_;
+    double stepSize_;
+    size_t stepNumber_{0};
+    thread_pool* pool_{nullptr};
+
+    std::vector<instance_wrapper> instances_;
+    std::vector<connection*> connections_;
+    std::unordered_map<std::string, int> priorities_;
+    std::vector<variable_identifier> delayedInputs_;
+
+    bool scheduleOutdated_{true};
+    std::vector<std::vector<size_t>> stages_; // instances stepped together, in order
+    std::vector<size_t> consumers_;           // instances with inputs not transferred right before stepping
+
+    static bool should_step(size_t step, int factor)
+    {
+        return step % factor == 0;
+    }
+
+    [[nodiscard]] bool is_delayed(const property& sink) const
+    {
+        const auto id = sink.id();
+        return std::ranges::any_of(delayedInputs_, [&](const auto& pattern) {
+            return id.matches(pattern);
+        });
+    }
+
+    void build_schedule()
+    {
+        const size_t n = instances_.size();
+
+        std::unordered_map<std::string, size_t> instanceIndex;
+        for (size_t i = 0; i < n; ++i) {
+            auto& wrapper = instances_[i];
+            instanceIndex.emplace(wrapper.instance->instanceName(), i);
+            wrapper.inputs.clear();
+            const auto it = priorities_.find(wrapper.instance->instanceName());
+            wrapper.priority = it == priorities_.end() ? 0 : it->second;
+        }
+
+        struct edge
+        {
+            size_t from;
+            size_t to;
+            connection* c;
+        };
+        std::vector<edge> edges;
+        std::vector<std::vector<size_t>> adjacency(n);
+        // inputs of an instance not transferred by step(), i.e. delayed ones, are left to the simulation after each step
+        std::vector<size_t> numInputs(n, 0);
+        for (const auto c : connections_) {
+            const auto source = c->source_property();
+            const auto sink = c->sink_property();
+            if (sink) {
+                if (const auto it = instanceIndex.find(sink->id().instance_name()); it != instanceIndex.end()) {
+                    ++numInputs[it->second];
+                }
+            }
+            if (!source || !sink || is_delayed(*sink)) continue;
+
+            const auto from = instanceIndex.find(source->id().instance_name());
+            const auto to = instanceIndex.find(sink->id().instance_name());
+            if (from == instanceIndex.end() || to == instanceIndex.end() || from->second == to->second) continue;
+
+            edges.emplace_back(edge{from->second, to->second, c});
+            adjacency[from->second].emplace_back(to->second);
+        }
+
+        // rank instances within each cycle, edges against the rank are delayed
+        std::vector<size_t> component(n);
+        std::vector<size_t> rank(n);
+        const auto components = strongly_connected_components(adjacency);
+        for (size_t k = 0; k < components.size(); ++k) {
+            auto members = components[k];
+            std::ranges::sort(members, [&](size_t a, size_t b) {
+                if (instances_[a].priority != instances_[b].priority) {
+                    return instances_[a].priority > instances_[b].priority;
+                }
+                return a < b;
+            });
+            for (size_t r = 0; r < members.size(); ++r) {
+                component[members[r]] = k;
+                rank[members[r]] = r;
+            }
+        }
+
+        std::vector<std::vector<size_t>> successors(n);
+        std::vector<size_t> numPredecessors(n, 0);
+        size_t numDelayed = 0;
+        for (const auto& e : edges) {
+            if (component[e.from] == component[e.to] && rank[e.from] > rank[e.to]) {
+                log::debug("Delaying connection {} -> {} to break a cycle", e.c->source_property()->id().str(), e.c->sink_property()->id().str());
+                ++numDelayed;
+                continue;
+            }
+            instances_[e.to].inputs.emplace_back(e.c);
+            successors[e.from].emplace_back(e.to);
+            ++numPredecessors[e.to];
+        }
+
+        consumers_.clear();
+        for (size_t i = 0; i < n; ++i) {
+            if (instances_[i].inputs.size() < numInputs[i]) {
+                consumers_.emplace_back(i);
+            }
+        }
+
+        // stage of an instance is the length of the longest chain of upstream instances,
+        // such that instances within a stage never depend on each other
+        stages_.clear();
+        std::vector<size_t> stage(n, 0);
+        std::vector<size_t> ready;
+        for (size_t i = 0; i < n; ++i) {
+            if (numPredecessors[i] == 0) {
+                ready.emplace_back(i);
+            }
+        }
+        while (!ready.empty()) {
+            const size_t i = ready.back();
+            ready.pop_back();
+            if (stages_.size() <= stage[i]) {
+                stages_.resize(stage[i] + 1);
+            }
+            stages_[stage[i]].emplace_back(i);
+            for (const auto j : successors[i]) {
+                stage[j] = std::max(stage[j], stage[i] + 1);
+                if (--numPredecessors[j] == 0) {
+                    ready.emplace_back(j);
+                }
+            }
+        }
+        for (auto& s : stages_) {
+            std::ranges::sort(s);
+        }
+
+        log::debug("Gauss-Seidel schedule of {} instances in {} stages, {} connections delayed to break cycles",
+            n, stages_.size(), numDelayed);
+    }
+};
+
+
+gauss_seidel_algorithm::gauss_seidel_algorithm(double stepSize, bool parallel)
+    : pimpl_(std::make_unique<impl>(stepSize, parallel))
+{ }
+
+void gauss_seidel_algorithm::set_priority(const std::string& instanceName, int priority)
+{
+    pimpl_->set_priority(instanceName, priority);
+}
+
+void gauss_seidel_algorithm::delay_input(const variable_identifier& pattern)
+{
+    pimpl_->delay_input(pattern);
+}
+
+void gauss_seidel_algorithm::model_instance_added(model_instance* instance)
+{
+    pimpl_->model_instance_added(instance);
+}
+
+void gauss_seidel_algorithm::connection_added(connection* c)
+{
+    pimpl_->connection_added(c);
+}
+
+double gauss_seidel_algorithm::step(double currentTime)
+{
+    return pimpl_->step(currentTime);
+}
+
+const std::vector<size_t>* gauss_seidel_algorithm::pending_consumers() const
+{
+    return pimpl_->pending_consumers();
+}
+
+bool gauss_seidel_algorithm::updates_all_instances() const
+{
+    return true;
+}
+
+void gauss_seidel_algorithm::set_thread_pool(thread_pool* pool)
+{
+    pimpl_->set_thread_pool(pool);
+}
+
+gauss_seidel_algorithm::~gauss_seidel_algorithm() = default;
@@ -0,0 +1,242 @@
+#include "connection_plan.hpp"
+
+#include "ecos/logger/logger.hpp"
+
+#include <type_traits>
+#include <typeinfo>
+
+using namespace ecos;
+
+template<class T>
+uint32_t connection_plan::lane<T>::source_index(property_t<T>* source)
+{
+    if (const auto it = sourceIndex.find(source); it != sourceIndex.end()) {
+        return it->second;
+    }
+    const auto index = static_cast<uint32_t>(sources.size());
+    sources.emplace_back(source);
+    sourceIndex.emplace(source, index);
+    return index;
+}
+
+template<class T>
+void connection_plan::lane<T>::add_sink(property_t<T>* sink, uint32_t source, const value_store* store)
+{
+    if (const auto offset = sink->store_index(); store && offset && !sink->has_input_modifier()) {
+        storedSinks.emplace_back(static_cast<uint32_t>(sinks.size()));
+        storedSinkOffsets.emplace_back(*offset);
+    }
+    sinks.emplace_back(sink);
+    sinkSources.emplace_back(source);
+}
+
+template<class T>
+void connection_plan::lane<T>::partition_sources(const value_store* store)
+{
+    values.resize(sources.size());
+    for (uint32_t i = 0; i < sources.size(); ++i) {
+        const auto source = sources[i];
+        if (const auto offset = source->store_index(); store && offset && !source->has_output_modifier()) {
+            // the store is only kept up to date for variables subscribed to
+            source->subscribe();
+            storedValues.emplace_back(i);
+            storedOffsets.emplace_back(*offset);
+        } else {
+            computedValues.emplace_back(i);
+        }
+    }
+    sourceIndex.clear();
+}
+
+template<class T>
+void connection_plan::lane<T>::drop_stored_sinks(const std::unordered_set<const property*>& allSources)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < storedSinks.size(); ++i) {
+        if (!allSources.contains(sinks[storedSinks[i]])) {
+            storedSinks[kept] = storedSinks[i];
+            storedSinkOffsets[kept] = storedSinkOffsets[i];
+            ++kept;
+        }
+    }
+    storedSinks.resize(kept);
+    storedSinkOffsets.resize(kept);
+}
+
+template<class T>
+template<class S>
+void connection_plan::lane<T>::transfer(std::span<S> store)
+{
+    const size_t numStored = storedValues.size();
+    for (size_t i = 0; i < numStored; ++i) {
+        values[storedValues[i]] = static_cast<T>(store[storedOffsets[i]]);
+    }
+    for (const auto i : computedValues) {
+        values[i] = sources[i]->get_value();
+    }
+
+    const size_t numSinks = sinks.size();
+    for (size_t i = 0; i < numSinks; ++i) {
+        sinks[i]->set_value(values[sinkSources[i]]);
+    }
+
+    const size_t numStoredSinks = storedSinks.size();
+    for (size_t i = 0; i < numStoredSinks; ++i) {
+        store[storedSinkOffsets[i]] = static_cast<S>(values[sinkSources[storedSinks[i]]]);
+    }
+
+    if constexpr (std::is_same_v<T, double>) {
+        for (size_t i = 0; i < modified.size(); ++i) {
+            const auto c = modified[i];
+            double value = values[modifiedSources[i]];
+            if (c->modifier) {
+                value = c->modifier.value()(value);
+            }
+            if (c->accept(value)) {
+                c->sink->set_value(value);
+            }
+        }
+    }
+}
+
+template<class T>
+size_t connection_plan::lane<T>::size() const
+{
+    return sinks.size() + modified.size();
+}
+
+void connection_plan::compile(
+    const std::vector<std::unique_ptr<connection>>& connections,
+    value_store* store,
+    const std::vector<std::string>& instanceNames)
+{
+    store_ = store;
+
+    std::unordered_map<std::string, size_t> groupIndex;
+    for (size_t i = 0; i < instanceNames.size(); ++i) {
+        groupIndex.emplace(instanceNames[i], i);
+    }
+
+    groups_.clear();
+    groups_.resize(instanceNames.size() + 1);
+
+    std::unordered_set<const property*> allSources;
+    for (const auto& ptr : connections) {
+        connection* c = ptr.get();
+        allSources.emplace(c->source_property());
+
+        size_t g = instanceNames.size();
+        if (const auto sink = c->sink_property()) {
+            if (const auto it = groupIndex.find(sink->id().instance_name()); it != groupIndex.end()) {
+                g = it->second;
+            }
+        }
+        auto& group = groups_[g];
+
+        const auto& type = typeid(*c);
+        if (type == typeid(real_connection)) {
+            const auto rc = static_cast<real_connection*>(c);
+            const auto index = group.reals.source_index(rc->source);
+            rc->reset_deadband();
+            if (rc->modifier || rc->deadband() > 0) {
+                group.reals.modified.emplace_back(rc);
+                group.reals.modifiedSources.emplace_back(index);
+            } else {
+                group.reals.add_sink(rc->sink, index, store);
+            }
+        } else if (type == typeid(int_connection)) {
+            const auto ic = static_cast<int_connection*>(c);
+            group.integers.add_sink(ic->sink, group.integers.source_index(ic->source), store);
+        } else if (type == typeid(bool_connection)) {
+            const auto bc = static_cast<bool_connection*>(c);
+            group.booleans.add_sink(bc->sink, group.booleans.source_index(bc->source), store);
+        } else if (type == typeid(string_connection)) {
+            const auto sc = static_cast<string_connection*>(c);
+            group.strings.add_sink(sc->sink, group.strings.source_index(sc->source), store);
+        } else if (type == typeid(int64_connection)) {
+            const auto lc = static_cast<int64_connection*>(c);
+            group.int64s.add_sink(lc->sink, group.int64s.source_index(lc->source), store);
+        } else if (type == typeid(uint64_connection)) {
+            const auto uc = static_cast<uint64_connection*>(c);
+            group.uint64s.add_sink(uc->sink, group.uint64s.source_index(uc->source), store);
+        } else if (type == typeid(float32_connection)) {
+            const auto fc = static_cast<float32_connection*>(c);
+            group.float32s.add_sink(fc->sink, group.float32s.source_index(fc->source), store);
+        } else {
+            group.generic.emplace_back(c);
+        }
+    }
+
+    size_t numStoredSources = 0;
+    size_t numStoredSinks = 0;
+    for (auto& group : groups_) {
+        group.reals.drop_stored_sinks(allSources);
+        group.integers.drop_stored_sinks(allSources);
+        group.booleans.drop_stored_sinks(allSources);
+        group.strings.drop_stored_sinks(allSources);
+        group.int64s.drop_stored_sinks(allSources);
+        group.uint64s.drop_stored_sinks(allSources);
+        group.float32s.drop_stored_sinks(allSources);
+
+        group.reals.partition_sources(store);
+        group.integers.partition_sources(store);
+        group.booleans.partition_sources(store);
+        group.strings.partition_sources(store);
+        group.int64s.partition_sources(store);
+        group.uint64s.partition_sources(store);
+        group.float32s.partition_sources(store);
+
+        numStoredSources += group.reals.storedValues.size() + group.integers.storedValues.size() +
+            group.booleans.storedValues.size() + group.strings.storedValues.size() +
+            group.int64s.storedValues.size() + group.uint64s.storedValues.size() + group.float32s.storedValues.size();
+        numStoredSinks += group.reals.storedSinks.size() + group.integers.storedSinks.size() +
+            group.booleans.storedSinks.size() + group.strings.storedSinks.size() +
+            group.int64s.storedSinks.size() + group.uint64s.storedSinks.size() + group.float32s.storedSinks.size();
+    }
+
+    log::debug("Compiled {} connections into {} sink groups, {} sources read from and {} sinks written through to the value store",
+        size(), groups_.size(), numStoredSources, numStoredSinks);
+}
+
+void connection_plan::transfer()
+{
+    for (size_t g = 0; g < groups_.size(); ++g) {
+        transfer(g);
+    }
+}
+
+void connection_plan::transfer(size_t g)
+{
+    auto& group = groups_[g];
+    if (store_) {
+        group.reals.transfer(store_->reals());
+        group.integers.transfer(store_->integers());
+        group.booleans.transfer(store_->booleans());
+        group.strings.transfer(store_->strings());
+        group.int64s.transfer(store_->int64s());
+        group.uint64s.transfer(store_->uint64s());
+        group.float32s.transfer(store_->float32s());
+    } else {
+        group.reals.transfer(std::span<double>());
+        group.integers.transfer(std::span<int32_t>());
+        group.booleans.transfer(std::span<uint8_t>());
+        group.strings.transfer(std::span<std::string>());
+        group.int64s.transfer(std::span<int64_t>());
+        group.uint64s.transfer(std::span<uint64_t>());
+        group.float32s.transfer(std::span<float>());
+    }
+
+    for (const auto c : group.generic) {
+        c->transferData();
+    }
+}
+
+size_t connection_plan::size() const
+{
+    size_t size = 0;
+    for (const auto& group : groups_) {
+        size += group.reals.size() + group.integers.size() + group.booleans.size() + group.strings.size() +
+            group.int64s.size() + group.uint64s.size() + group.float32s.size() + group.generic.size();
+    }
+    return size;
+}
@@ -0,0 +1,125 @@
+#ifndef ECOS_CONNECTION_PLAN_HPP
+#define ECOS_CONNECTION_PLAN_HPP
+
+#include "ecos/connection.hpp"
+#include "ecos/value_store.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ecos
+{
+
+/**
+ * \brief Compiled, type-segregated representation of a set of connections.
+ *
+ * Built once from the connections of a simulation. Connections are grouped by the model instance owning the sink,
+ * so that the inputs of a single instance can be transferred on their own.
+ * Within a group, each distinct source is read exactly once per transfer into a contiguous per-type value buffer,
+ * which is then scattered into the sinks using flat index arrays.
+ * Sources backed by the value_store (and without an output modifier) are read directly by offset.
+ * Store backed sinks without an input modifier also have the transferred value written through to the store,
+ * so that it can be observed before it has been applied to the model.
+ * Connections without a modifier or deadband are moved in a dedicated, branch-free loop.
+ * Compiling resets the deadband reference value of every real connection.
+ * Connections of other types (e.g. type-converting connections) fall back to connection::transferData().
+ */
+class connection_plan
+{
+
+public:
+    // Sinks are grouped by the index of their instance within instanceNames.
+    // Sinks of other (or unknown) instances form an additional, last group.
+    void compile(
+        const std::vector<std::unique_ptr<connection>>& connections,
+        value_store* store = nullptr,
+        const std::vector<std::string>& instanceNames = {});
+
+    // Transfers all connections.
+    void transfer();
+
+    // Transfers the connections whose sink belongs to the given group.
+    void transfer(size_t group);
+
+    [[nodiscard]] size_t num_groups() const
+    {
+        return groups_.size();
+    }
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    template<class T>
+    struct lane
+    {
+        // distinct sources and their gathered values (parallel arrays)
+        std::vector<property_t<T>*> sources;
+        std::vector<T> values;
+
+        // sources read from the value store, values[storedValues[i]] = store[storedOffsets[i]]
+        std::vector<uint32_t> storedValues;
+        std::vector<size_t> storedOffsets;
+
+        // sources read through property_t::get_value()
+        std::vector<uint32_t> computedValues;
+
+        // connections without a modifier
+        std::vector<property_t<T>*> sinks;
+        std::vector<uint32_t> sinkSources;
+
+        // store backed sinks, store[storedSinkOffsets[i]] = values[sinkSources[storedSinks[i]]]
+        std::vector<uint32_t> storedSinks;
+        std::vector<size_t> storedSinkOffsets;
+
+        // connections with a modifier and/or a deadband
+        std::vector<real_connection*> modified;
+        std::vector<uint32_t> modifiedSources;
+
+        // only used while compiling
+        std::unordered_map<property_t<T>*, uint32_t> sourceIndex;
+
+        uint32_t source_index(property_t<T>* source);
+
+        void add_sink(property_t<T>* sink, uint32_t source, const value_store* store);
+
+        void partition_sources(const value_store* store);
+
+        // sinks that are also read as a source somewhere are not written through, to keep transfers order independent
+        void drop_stored_sinks(const std::unordered_set<const property*>& allSources);
+
+        template<class S>
+        void transfer(std::span<S> store);
+
+        [[nodiscard]] size_t size() const;
+    };
+
+    struct group
+    {
+        lane<double> reals;
+        lane<int> integers;
+        lane<bool> booleans;
+        lane<std::string> strings;
+        lane<int64_t> int64s;
+        lane<uint64_t> uint64s;
+        lane<float> float32s;
+
+        std::vector<connection*> generic;
+    };
+
+    std::vector<group> groups_;
+
+    value_store* store_{nullptr};
+};
+
+} // namespace ecos
+
+#endif // ECOS_CONNECTION_PLAN_HPP
@@ -251,6 +251,17 @@ ecos_simulation_t* ecos_simulation_create_from_structure(ecos_simulation_structu
     }
 }
 
+bool ecos_simulation_set_num_threads(ecos_simulation_t* sim, size_t numThreads, bool pin)
+{
+    try {
+        sim->cpp_sim->set_num_threads(numThreads, pin);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
 bool ecos_simulation_init(ecos_simulation_t* sim, double startTime, const char* parameterSet)
 {
     try {
@@ -452,6 +463,245 @@ bool ecos_simulation_set_binary(ecos_simulation_t* sim, const char* identifier,
     }
 }
 
+bool ecos_simulation_resolve(ecos_simulation_t* sim, const char* identifier, size_t* handle)
+{
+    try {
+        *handle = sim->cpp_sim->resolve(identifier).index();
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_integer_by_handle(ecos_simulation_t* sim, size_t handle, int* value)
+{
+    try {
+        *value = sim->cpp_sim->get<int>(ecos::variable_handle(handle));
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_real_by_handle(ecos_simulation_t* sim, size_t handle, double* value)
+{
+    try {
+        *value = sim->cpp_sim->get<double>(ecos::variable_handle(handle));
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_bool_by_handle(ecos_simulation_t* sim, size_t handle, bool* value)
+{
+    try {
+        *value = sim->cpp_sim->get<bool>(ecos::variable_handle(handle));
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_integer_by_handle(ecos_simulation_t* sim, size_t handle, int value)
+{
+    try {
+        sim->cpp_sim->set<int>(ecos::variable_handle(handle), value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_real_by_handle(ecos_simulation_t* sim, size_t handle, double value)
+{
+    try {
+        sim->cpp_sim->set<double>(ecos::variable_handle(handle), value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_bool_by_handle(ecos_simulation_t* sim, size_t handle, bool value)
+{
+    try {
+        sim->cpp_sim->set<bool>(ecos::variable_handle(handle), value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_int64(ecos_simulation_t* sim, const char* identifier, int64_t* value)
+{
+    try {
+        const auto prop = sim->cpp_sim->get_int64_property(identifier);
+        if (!prop) {
+            g_last_error_msg = "No int64 property " + std::string(identifier) + " found!";
+            return false;
+        }
+        *value = prop->get_value();
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_int64(ecos_simulation_t* sim, const char* identifier, int64_t value)
+{
+    try {
+        const auto prop = sim->cpp_sim->get_int64_property(identifier);
+        if (!prop) {
+            g_last_error_msg = "No int64 property " + std::string(identifier) + " found!";
+            return false;
+        }
+        prop->set_value(value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_int64_by_handle(ecos_simulation_t* sim, size_t handle, int64_t* value)
+{
+    try {
+        *value = sim->cpp_sim->get<int64_t>(ecos::variable_handle(handle));
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_int64_by_handle(ecos_simulation_t* sim, size_t handle, int64_t value)
+{
+    try {
+        sim->cpp_sim->set<int64_t>(ecos::variable_handle(handle), value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_uint64(ecos_simulation_t* sim, const char* identifier, uint64_t* value)
+{
+    try {
+        const auto prop = sim->cpp_sim->get_uint64_property(identifier);
+        if (!prop) {
+            g_last_error_msg = "No uint64 property " + std::string(identifier) + " found!";
+            return false;
+        }
+        *value = prop->get_value();
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_uint64(ecos_simulation_t* sim, const char* identifier, uint64_t value)
+{
+    try {
+        const auto prop = sim->cpp_sim->get_uint64_property(identifier);
+        if (!prop) {
+            g_last_error_msg = "No uint64 property " + std::string(identifier) + " found!";
+            return false;
+        }
+        prop->set_value(value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_uint64_by_handle(ecos_simulation_t* sim, size_t handle, uint64_t* value)
+{
+    try {
+        *value = sim->cpp_sim->get<uint64_t>(ecos::variable_handle(handle));
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_uint64_by_handle(ecos_simulation_t* sim, size_t handle, uint64_t value)
+{
+    try {
+        sim->cpp_sim->set<uint64_t>(ecos::variable_handle(handle), value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_float32(ecos_simulation_t* sim, const char* identifier, float* value)
+{
+    try {
+        const auto prop = sim->cpp_sim->get_float32_property(identifier);
+        if (!prop) {
+            g_last_error_msg = "No float32 property " + std::string(identifier) + " found!";
+            return false;
+        }
+        *value = prop->get_value();
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_float32(ecos_simulation_t* sim, const char* identifier, float value)
+{
+    try {
+        const auto prop = sim->cpp_sim->get_float32_property(identifier);
+        if (!prop) {
+            g_last_error_msg = "No float32 property " + std::string(identifier) + " found!";
+            return false;
+        }
+        prop->set_value(value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_get_float32_by_handle(ecos_simulation_t* sim, size_t handle, float* value)
+{
+    try {
+        *value = sim->cpp_sim->get<float>(ecos::variable_handle(handle));
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
+bool ecos_simulation_set_float32_by_handle(ecos_simulation_t* sim, size_t handle, float value)
+{
+    try {
+        sim->cpp_sim->set<float>(ecos::variable_handle(handle), value);
+        return true;
+    } catch (...) {
+        handle_current_exception();
+        return false;
+    }
+}
+
 
 void ecos_simulation_add_listener(ecos_simulation_t* sim, const char* name, ecos_simulation_listener_t* listener)
 {
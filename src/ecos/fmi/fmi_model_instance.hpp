@@ -38,69 +38,33 @@ public:
     explicit fmi_model_instance(std::unique_ptr<fmilibcpp::slave> slave, std::optional<double> stepSizeHint)
         : model_instance(slave->instanceName, stepSizeHint)
         , slave_(std::make_unique<fmilibcpp::buffered_slave>(std::move(slave)))
+        , integers_(*slave_)
+        , reals_(*slave_)
+        , strings_(*slave_)
+        , booleans_(*slave_)
+        , int64s_(*slave_)
+        , uint64s_(*slave_)
+        , float32s_(*slave_)
     {
 
         const auto name = slave_->instanceName;
         const auto& md = slave_->get_model_description();
-        for (const auto& v : md.modelVariables) {
+        for (const auto& v : md.variables()) {
             std::string propertyName(v.name);
             if (v.is_integer()) {
-                auto p = property_t<int>(
-                    {slave_->instanceName, propertyName},
-                    [&v, this] {
-                        vrBuf[0] = v.vr;
-                        slave_->get_integer(vrBuf, iBuf);
-                        return iBuf.back();
-                    },
-                    [&v, this](auto value) {
-                        vrBuf[0] = v.vr;
-                        iBuf[0] = value;
-                        slave_->set_integer(vrBuf, iBuf);
-                    });
-                properties_.add_int_property(std::move(p));
+                properties_.add_int_property(property_t<int>({name, propertyName}, integers_, slave_->integer_slot(v.vr)));
             } else if (v.is_real()) {
-                auto p = property_t<double>(
-                    {slave_->instanceName, propertyName},
-                    [&v, this] {
-                        vrBuf[0] = v.vr;
-                        slave_->get_real(vrBuf, rBuf);
-                        return rBuf.back();
-                    },
-                    [&v, this](auto value) {
-                        vrBuf[0] = v.vr;
-                        rBuf[0] = value;
-                        slave_->set_real(vrBuf, rBuf);
-                    });
-                properties_.add_real_property(std::move(p));
+                properties_.add_real_property(property_t<double>({name, propertyName}, reals_, slave_->real_slot(v.vr)));
             } else if (v.is_string()) {
-                auto p = property_t<std::string>(
-                    {slave_->instanceName, propertyName},
-                    [&v, this] {
-                        vrBuf[0] = v.vr;
-                        slave_->get_string(vrBuf, sBuf);
-                        return sBuf.back();
-                    },
-                    [&v, this](auto& value) {
-                        vrBuf[0] = v.vr;
-                        sBuf[0] = value;
-                        slave_->set_string(vrBuf, sBuf);
-                    });
-                properties_.add_string_property(std::move(p));
+                properties_.add_string_property(property_t<std::string>({name, propertyName}, strings_, slave_->string_slot(v.vr)));
             } else if (v.is_boolean()) {
-                auto p = property_t<bool>(
-                    {slave_->instanceName, propertyName},
-                    [&v, this] {
-                        vrBuf[0] = v.vr;
-                        slave_->get_boolean(vrBuf, bBuf);
-                        return bBuf.back();
-                    },
-                    [&v, this](auto value) {
-                        vrBuf[0] = v.vr;
-                        bBuf[0] = value;
-                        slave_->set_boolean(vrBuf, bBuf);
-                        return bBuf.back();
-                    });
-                properties_.add_bool_property(std::move(p));
+                properties_.add_bool_property(property_t<bool>({name, propertyName}, booleans_, slave_->boolean_slot(v.vr)));
+            } else if (v.is_int64()) {
+                properties_.add_int64_property(property_t<int64_t>({name, propertyName}, int64s_, slave_->int64_slot(v.vr)));
+            } else if (v.is_uint64()) {
+                properties_.add_uint64_property(property_t<uint64_t>({name, propertyName}, uint64s_, slave_->uint64_slot(v.vr)));
+            } else if (v.is_float32()) {
+                properties_.add_float32_property(property_t<float>({name, propertyName}, float32s_, slave_->float32_slot(v.vr)));
             } else if (v.is_binary()) {
                 auto p = property_t<std::vector<uint8_t>>(
                    {slave_->instanceName, propertyName},
@@ -147,6 +111,10 @@ public:
     void terminate() override
     {
         slave_->terminate();
+
+        const auto& stats = slave_->get_set_statistics();
+        log::debug("[{}] {} values set, {} unchanged values skipped; {} set calls made, {} avoided",
+            instanceName_, stats.valuesQueued, stats.valuesSkipped, stats.callsIssued, stats.callsSkipped);
     }
 
     void reset() override
@@ -154,6 +122,43 @@ public:
         slave_->reset();
     }
 
+    [[nodiscard]] value_count value_layout() const override
+    {
+        return {slave_->num_reals(), slave_->num_integers(), slave_->num_booleans(), slave_->num_strings(),
+            slave_->num_int64s(), slave_->num_uint64s(), slave_->num_float32s()};
+    }
+
+    void bind_value_store(value_store& store, const value_slice& slice) override
+    {
+        slave_->attach_buffers(
+            store.integers(slice).data(),
+            store.reals(slice).data(),
+            store.booleans(slice).data(),
+            store.strings(slice).data(),
+            store.int64s(slice).data(),
+            store.uint64s(slice).data(),
+            store.float32s(slice).data());
+        sync_buffers();
+
+        for (const auto& v : slave_->get_model_description().variables()) {
+            if (v.is_integer()) {
+                properties_.get_int_property(v.name)->bind_store_index(slice.integerOffset + slave_->integer_slot(v.vr));
+            } else if (v.is_real()) {
+                properties_.get_real_property(v.name)->bind_store_index(slice.realOffset + slave_->real_slot(v.vr));
+            } else if (v.is_string()) {
+                properties_.get_string_property(v.name)->bind_store_index(slice.stringOffset + slave_->string_slot(v.vr));
+            } else if (v.is_boolean()) {
+                properties_.get_bool_property(v.name)->bind_store_index(slice.booleanOffset + slave_->boolean_slot(v.vr));
+            } else if (v.is_int64()) {
+                properties_.get_int64_property(v.name)->bind_store_index(slice.int64Offset + slave_->int64_slot(v.vr));
+            } else if (v.is_uint64()) {
+                properties_.get_uint64_property(v.name)->bind_store_index(slice.uint64Offset + slave_->uint64_slot(v.vr));
+            } else if (v.is_float32()) {
+                properties_.get_float32_property(v.name)->bind_store_index(slice.float32Offset + slave_->float32_slot(v.vr));
+            }
+        }
+    }
+
     [[nodiscard]] bool can_get_and_set_state() const override
     {
         return slave_->get_model_description().canGetAndSetState;
@@ -174,14 +179,127 @@ public:
     }
 
 private:
+    // Value buffer of a single type, read directly by properties and written through the slot based setters of the slave
+    template<class T>
+    struct slave_buffer : value_buffer<T>
+    {
+        explicit slave_buffer(fmilibcpp::buffered_slave& slave)
+            : slave_(slave)
+        {
+            sync();
+        }
+
+        void sync()
+        {
+            this->generation = slave_.generation();
+            if constexpr (std::is_same_v<T, int>) {
+                this->values = slave_.integer_values();
+                this->fetchedAt = slave_.integer_fetched_at();
+            } else if constexpr (std::is_same_v<T, double>) {
+                this->values = slave_.real_values();
+                this->fetchedAt = slave_.real_fetched_at();
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                this->values = slave_.string_values();
+                this->fetchedAt = slave_.string_fetched_at();
+            } else if constexpr (std::is_same_v<T, int64_t>) {
+                this->values = slave_.int64_values();
+                this->fetchedAt = slave_.int64_fetched_at();
+            } else if constexpr (std::is_same_v<T, uint64_t>) {
+                this->values = slave_.uint64_values();
+                this->fetchedAt = slave_.uint64_fetched_at();
+            } else if constexpr (std::is_same_v<T, float>) {
+                this->values = slave_.float32_values();
+                this->fetchedAt = slave_.float32_fetched_at();
+            } else {
+                this->values = slave_.boolean_values();
+                this->fetchedAt = slave_.boolean_fetched_at();
+            }
+        }
+
+        void subscribe(size_t slot) override
+        {
+            if constexpr (std::is_same_v<T, int>) {
+                slave_.subscribe_integer(slot);
+            } else if constexpr (std::is_same_v<T, double>) {
+                slave_.subscribe_real(slot);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                slave_.subscribe_string(slot);
+            } else if constexpr (std::is_same_v<T, int64_t>) {
+                slave_.subscribe_int64(slot);
+            } else if constexpr (std::is_same_v<T, uint64_t>) {
+                slave_.subscribe_uint64(slot);
+            } else if constexpr (std::is_same_v<T, float>) {
+                slave_.subscribe_float32(slot);
+            } else {
+                slave_.subscribe_boolean(slot);
+            }
+        }
+
+        void refresh(size_t slot) override
+        {
+            if constexpr (std::is_same_v<T, int>) {
+                slave_.refresh_integer(slot);
+            } else if constexpr (std::is_same_v<T, double>) {
+                slave_.refresh_real(slot);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                slave_.refresh_string(slot);
+            } else if constexpr (std::is_same_v<T, int64_t>) {
+                slave_.refresh_int64(slot);
+            } else if constexpr (std::is_same_v<T, uint64_t>) {
+                slave_.refresh_uint64(slot);
+            } else if constexpr (std::is_same_v<T, float>) {
+                slave_.refresh_float32(slot);
+            } else {
+                slave_.refresh_boolean(slot);
+            }
+        }
+
+        void set(size_t slot, const T& value) override
+        {
+            if constexpr (std::is_same_v<T, int>) {
+                slave_.set_integer_at(slot, value);
+            } else if constexpr (std::is_same_v<T, double>) {
+                slave_.set_real_at(slot, value);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                slave_.set_string_at(slot, value);
+            } else if constexpr (std::is_same_v<T, int64_t>) {
+                slave_.set_int64_at(slot, value);
+            } else if constexpr (std::is_same_v<T, uint64_t>) {
+                slave_.set_uint64_at(slot, value);
+            } else if constexpr (std::is_same_v<T, float>) {
+                slave_.set_float32_at(slot, value);
+            } else {
+                slave_.set_boolean_at(slot, value);
+            }
+        }
+
+    private:
+        fmilibcpp::buffered_slave& slave_;
+    };
+
     std::vector<fmilibcpp::value_ref> vrBuf = std::vector<fmilibcpp::value_ref>(1);
-    std::vector<double> rBuf = std::vector<double>(1);
-    std::vector<int> iBuf = std::vector<int>(1);
-    std::vector<bool> bBuf = std::vector<bool>(1);
-    std::vector<std::string> sBuf = std::vector<std::string>(1);
     std::vector<std::vector<uint8_t>> binBuf = std::vector<std::vector<uint8_t>>(1);
     std::unique_ptr<fmilibcpp::buffered_slave> slave_;
 
+    slave_buffer<int> integers_;
+    slave_buffer<double> reals_;
+    slave_buffer<std::string> strings_;
+    slave_buffer<bool> booleans_;
+    slave_buffer<int64_t> int64s_;
+    slave_buffer<uint64_t> uint64s_;
+    slave_buffer<float> float32s_;
+
+    void sync_buffers()
+    {
+        integers_.sync();
+        reals_.sync();
+        strings_.sync();
+        booleans_.sync();
+        int64s_.sync();
+        uint64s_.sync();
+        float32s_.sync();
+    }
+
     struct prop_lister : property_listener
     {
 
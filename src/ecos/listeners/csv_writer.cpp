@@ -95,7 +95,7 @@ void csv_config::report(const std::vector<variable_identifier>& ids) const
 
             if (!matched) {
                 if (missingCount++ > 0) missing << ", ";
-                missing << pattern.str();
+                missing << pattern;
             }
         }
         if (missingCount > 0) {
@@ -176,33 +176,61 @@ void csv_writer::write_header(const simulation& sim)
 
     config_.report(sim.identifiers());
 
+    // values logged every step are fetched along with the connected outputs, otherwise on demand
+    const bool subscribe = config_.decimation_factor() == 1;
+
     for (const auto& instance : sim.get_instances()) {
 
-        const auto instanceName = instance->instanceName();
+        const auto& instanceName = instance->instanceName();
         auto& properties = instance->get_properties();
 
         for (const auto& [variableName, p] : properties.get_reals()) {
-            if (config_.should_log({instanceName, variableName})) {
+            if (config_.should_log(p.id())) {
                 line << separator << instanceName << "::" << variableName << "[REAL]";
                 props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
             }
         }
         for (const auto& [variableName, p] : properties.get_integers()) {
-            if (config_.should_log({instanceName, variableName})) {
+            if (config_.should_log(p.id())) {
                 line << separator << instanceName << "::" << variableName << "[INT]";
                 props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
             }
         }
         for (const auto& [variableName, p] : properties.get_booleans()) {
-            if (config_.should_log({instanceName, variableName})) {
+            if (config_.should_log(p.id())) {
                 line << separator << instanceName << "::" << variableName << "[BOOL]";
                 props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
             }
         }
         for (const auto& [variableName, p] : properties.get_strings()) {
-            if (config_.should_log({instanceName, variableName})) {
+            if (config_.should_log(p.id())) {
                 line << separator << instanceName << "::" << variableName << "[STR]";
                 props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
+            }
+        }
+        for (const auto& [variableName, p] : properties.get_int64s()) {
+            if (config_.should_log(p.id())) {
+                line << separator << instanceName << "::" << variableName << "[INT64]";
+                props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
+            }
+        }
+        for (const auto& [variableName, p] : properties.get_uint64s()) {
+            if (config_.should_log(p.id())) {
+                line << separator << instanceName << "::" << variableName << "[UINT64]";
+                props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
+            }
+        }
+        for (const auto& [variableName, p] : properties.get_float32s()) {
+            if (config_.should_log(p.id())) {
+                line << separator << instanceName << "::" << variableName << "[FLOAT32]";
+                props_.emplace_back(&p);
+                if (subscribe) p.subscribe();
             }
         }
     }
@@ -28,6 +28,8 @@ spdlog::level::level_enum convert(log::level lvl)
     }
 }
 
+thread_local log::captured_messages* capture = nullptr;
+
 } // namespace
 
 struct ecos_logger
@@ -67,5 +69,28 @@ void log::set_logging_level(level lvl)
 
 void log::log(level lvl, std::string_view msg)
 {
+    if (capture) {
+        capture->messages.emplace_back(lvl, msg);
+        return;
+    }
     ecos_logger::get_instance().log(lvl, msg);
 }
+
+void log::captured_messages::flush()
+{
+    for (const auto& [lvl, msg] : messages) {
+        log::log(lvl, msg);
+    }
+    messages.clear();
+}
+
+log::scoped_capture::scoped_capture(captured_messages& target)
+    : previous_(capture)
+{
+    capture = &target;
+}
+
+log::scoped_capture::~scoped_capture()
+{
+    capture = previous_;
+}
@@ -14,6 +14,12 @@ std::ostream& ecos::operator<<(std::ostream& os, const property& p)
         os << std::noboolalpha << pb->get_value();
     } else if (const auto ps = dynamic_cast<const property_t<std::string>*>(&p)) {
         os << ps->get_value();
+    } else if (const auto pl = dynamic_cast<const property_t<int64_t>*>(&p)) {
+        os << std::to_string(pl->get_value());
+    } else if (const auto pu = dynamic_cast<const property_t<uint64_t>*>(&p)) {
+        os << std::to_string(pu->get_value());
+    } else if (const auto pf = dynamic_cast<const property_t<float>*>(&p)) {
+        os << std::to_string(pf->get_value());
     } else {
         os << "<unknown property type>";
     }
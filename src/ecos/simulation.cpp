@@ -1,17 +1,79 @@
 
 #include "ecos/simulation.hpp"
 
+#include "connection_plan.hpp"
+#include "util/graph.hpp"
+
 #include "ecos/listeners/simulation_listener.hpp"
 #include "ecos/logger/logger.hpp"
 #include "ecos/property.hpp"
-
-#include <execution>
+#include "ecos/util/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <thread>
 #include <ranges>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
 
 using namespace ecos;
 
+namespace
+{
+
+// any value a connected output may hold, compared between the passes over an initialization cycle
+using output_value = std::variant<double, int, bool, std::string, std::vector<uint8_t>, int64_t, uint64_t, float>;
+
+output_value read_value(const property* p)
+{
+    if (const auto real = dynamic_cast<const property_t<double>*>(p)) return real->get_value();
+    if (const auto integer = dynamic_cast<const property_t<int>*>(p)) return integer->get_value();
+    if (const auto boolean = dynamic_cast<const property_t<bool>*>(p)) return boolean->get_value();
+    if (const auto str = dynamic_cast<const property_t<std::string>*>(p)) return str->get_value();
+    if (const auto binary = dynamic_cast<const property_t<std::vector<uint8_t>>*>(p)) return binary->get_value();
+    if (const auto int64 = dynamic_cast<const property_t<int64_t>*>(p)) return int64->get_value();
+    if (const auto uint64 = dynamic_cast<const property_t<uint64_t>*>(p)) return uint64->get_value();
+    if (const auto float32 = dynamic_cast<const property_t<float>*>(p)) return float32->get_value();
+    throw std::logic_error("Unsupported property type of " + p->id().str());
+}
+
+template<class T>
+bool changed(const output_value& previous, const output_value& current, double tolerance)
+{
+    const double a = std::get<T>(previous);
+    const double b = std::get<T>(current);
+    return !(std::abs(a - b) <= tolerance * (1 + std::abs(b)));
+}
+
+bool changed(const output_value& previous, const output_value& current, double tolerance)
+{
+    if (previous.index() == current.index()) {
+        if (std::holds_alternative<double>(current)) return changed<double>(previous, current, tolerance);
+        if (std::holds_alternative<float>(current)) return changed<float>(previous, current, tolerance);
+    }
+    return previous != current;
+}
+
+} // namespace
+
 struct simulation::Impl
 {
+    using property_ref = std::variant<
+        property_t<double>*,
+        property_t<int>*,
+        property_t<bool>*,
+        property_t<std::string>*,
+        property_t<std::vector<uint8_t>>*,
+        property_t<int64_t>*,
+        property_t<uint64_t>*,
+        property_t<float>*>;
+
     double lastDelta_{};
     double currentTime_{0};
     bool initialized_{false};
@@ -21,8 +83,21 @@ struct simulation::Impl
     std::unique_ptr<algorithm> algorithm_;
     std::vector<std::unique_ptr<model_instance>> instances_;
     std::vector<std::unique_ptr<connection>> connections_;
+    connection_plan plan_;
+    bool planOutdated_{true};
+    value_store store_;
+    size_t numThreads_{0};
+    bool pinThreads_{false};
+    double initTolerance_{1e-6};
+    size_t maxInitIterations_{100};
+    std::unique_ptr<thread_pool> pool_;
     std::unordered_map<std::string, std::shared_ptr<simulation_listener>> listeners_;
 
+    // lookup by name, populated as instances are added
+    std::unordered_map<std::string, model_instance*> instanceIndex_;
+    std::unordered_map<variable_identifier, size_t> variableIndex_; // into variables_
+    std::vector<property_ref> variables_;
+
     simulation& sim_;
 
     explicit Impl(simulation& sim, std::unique_ptr<algorithm> algorithm)
@@ -30,6 +105,143 @@ struct simulation::Impl
         , sim_(sim)
     { }
 
+    void compile_plan()
+    {
+        if (planOutdated_) {
+            std::vector<std::string> instanceNames;
+            for (const auto& instance : instances_) {
+                instanceNames.emplace_back(instance->instanceName());
+            }
+            plan_.compile(connections_, &store_, instanceNames);
+            planOutdated_ = false;
+        }
+    }
+
+    // Transfers connection data into the given instances (all if nullptr), and into sinks of unknown instances.
+    void transfer_data(const std::vector<size_t>* consumers = nullptr)
+    {
+        compile_plan();
+        if (!consumers) {
+            plan_.transfer();
+            return;
+        }
+        for (const auto i : *consumers) {
+            plan_.transfer(i);
+        }
+        plan_.transfer(plan_.num_groups() - 1);
+    }
+
+    void index_instance(model_instance* instance)
+    {
+        const auto& instanceName = instance->instanceName();
+        instanceIndex_.emplace(instanceName, instance);
+
+        auto& properties = instance->get_properties();
+        const auto add = [&](const std::string& name, property_ref p) {
+            if (variableIndex_.emplace(variable_identifier{instanceName, name}, variables_.size()).second) {
+                variables_.emplace_back(p);
+            }
+        };
+        for (const auto& name : properties.get_reals() | std::views::keys) {
+            add(name, properties.get_real_property(name));
+        }
+        for (const auto& name : properties.get_integers() | std::views::keys) {
+            add(name, properties.get_int_property(name));
+        }
+        for (const auto& name : properties.get_booleans() | std::views::keys) {
+            add(name, properties.get_bool_property(name));
+        }
+        for (const auto& name : properties.get_strings() | std::views::keys) {
+            add(name, properties.get_string_property(name));
+        }
+        for (const auto& name : properties.get_binaries() | std::views::keys) {
+            add(name, properties.get_binary_property(name));
+        }
+        for (const auto& name : properties.get_int64s() | std::views::keys) {
+            add(name, properties.get_int64_property(name));
+        }
+        for (const auto& name : properties.get_uint64s() | std::views::keys) {
+            add(name, properties.get_uint64_property(name));
+        }
+        for (const auto& name : properties.get_float32s() | std::views::keys) {
+            add(name, properties.get_float32_property(name));
+        }
+    }
+
+    template<class T>
+    [[nodiscard]] property_t<T>* find_property(const variable_identifier& identifier) const
+    {
+        const auto it = variableIndex_.find(identifier);
+        if (it == variableIndex_.end()) return nullptr;
+        const auto p = std::get_if<property_t<T>*>(&variables_[it->second]);
+        return p ? *p : nullptr;
+    }
+
+    template<class T>
+    [[nodiscard]] property_t<T>* resolved(variable_handle handle) const
+    {
+        if (handle.index() >= variables_.size()) {
+            throw std::out_of_range("Invalid variable handle: " + std::to_string(handle.index()));
+        }
+        const auto& ref = variables_[handle.index()];
+        const auto p = std::get_if<property_t<T>*>(&ref);
+        if (!p) {
+            const auto id = std::visit([](const auto* p) { return p->id(); }, ref);
+            throw std::runtime_error("Variable " + id.str() + " is accessed through a handle of the wrong type");
+        }
+        return *p;
+    }
+
+    void create_thread_pool()
+    {
+        size_t numThreads = numThreads_ == 0 ? std::thread::hardware_concurrency() : numThreads_;
+        if (numThreads_ == 0) {
+            numThreads = std::min(numThreads, instances_.size());
+        }
+        numThreads = std::max<size_t>(1, numThreads);
+
+        if (!pool_ || pool_->num_threads() != numThreads) {
+            algorithm_->set_thread_pool(nullptr);
+            pool_ = std::make_unique<thread_pool>(numThreads, pinThreads_);
+            log::debug("Created thread pool with {} threads", numThreads);
+        }
+        algorithm_->set_thread_pool(pool_.get());
+    }
+
+    template<class C>
+    C* add_connection(std::unique_ptr<C> c)
+    {
+        C* ptr = c.get();
+        // connected outputs are read after every step, and fetched along with the other outputs of their instance
+        if (const auto source = ptr->source_property()) {
+            source->subscribe();
+        }
+        connections_.emplace_back(std::move(c));
+        planOutdated_ = true;
+        algorithm_->connection_added(ptr);
+        return ptr;
+    }
+
+    void bind_value_store()
+    {
+        value_store store;
+        std::vector<value_slice> slices;
+        slices.reserve(instances_.size());
+        for (const auto& instance : instances_) {
+            slices.emplace_back(store.allocate(instance->value_layout()));
+        }
+        // pointers into the store are stable once everything has been allocated (and survive the move below).
+        // Instances copy their current values over, so any previous store must be kept alive until then.
+        for (unsigned i = 0; i < instances_.size(); ++i) {
+            instances_[i]->bind_value_store(store, slices[i]);
+        }
+        store_ = std::move(store);
+
+        log::debug("Value store holds {} reals, {} integers, {} booleans, {} strings, {} int64s, {} uint64s and {} float32s",
+            store_.reals().size(), store_.integers().size(), store_.booleans().size(), store_.strings().size(),
+            store_.int64s().size(), store_.uint64s().size(), store_.float32s().size());
+    }
+
     void set_debug_logging(bool flag)
     {
         for (const auto& instance : instances_) {
@@ -44,57 +256,187 @@ struct simulation::Impl
             initialized_ = true;
             log::debug("Initializing simulation..");
 
+            bind_value_store();
+            planOutdated_ = true;
+            create_thread_pool();
+
             for (auto l = listeners_; const auto& listener : l | std::views::values) {
                 listener->pre_init(sim_);
             }
 
-            int parameterSetAppliedCount = 0;
-            for (const auto& instance : instances_) {
-                const double start = startTime.value_or(0);
-                if (start < 0) {
-                    throw std::runtime_error("Explicitly defined startTime must be greater than 0!");
-                }
+            const double start = startTime.value_or(0);
+            if (start < 0) {
+                throw std::runtime_error("Explicitly defined startTime must be greater than 0!");
+            }
 
-                instance->enter_initialization_mode(start);
+            const auto t0 = clock::now();
+            std::atomic<int> parameterSetAppliedCount = 0;
+            for_each_instance([&](model_instance& instance) {
+                instance.enter_initialization_mode(start);
                 if (parameterSet) {
-                    if (instance->apply_parameter_set(*parameterSet)) {
+                    if (instance.apply_parameter_set(*parameterSet)) {
                         ++parameterSetAppliedCount;
                     }
                 }
-            }
+                instance.get_properties().apply_sets();
+                instance.get_properties().apply_gets();
+            });
             if (parameterSet) {
-                log::debug("Parameterset '{}' applied to {} instances", *parameterSet, parameterSetAppliedCount);
+                log::debug("Parameterset '{}' applied to {} instances", *parameterSet, parameterSetAppliedCount.load());
             }
 
-            for (unsigned i = 0; i < instances_.size(); ++i) {
-                for (const auto& instance : instances_) {
-                    instance->get_properties().apply_sets();
-                    instance->get_properties().apply_gets();
-                }
-                for (const auto& c : connections_) {
-                    c->transferData();
-                }
-            }
+            const auto t1 = clock::now();
+            initialize_connected();
 
-            for (const auto& instance : instances_) {
-                instance->exit_initialization_mode();
-                instance->get_properties().apply_gets();
+            const auto t2 = clock::now();
+            for_each_instance([](model_instance& instance) {
+                instance.exit_initialization_mode();
+                instance.get_properties().apply_gets();
+            });
+
+            transfer_data();
+
+            for_each_instance([](model_instance& instance) {
+                instance.get_properties().apply_sets();
+                instance.get_properties().apply_gets();
+            });
+            const auto t3 = clock::now();
+
+            for (auto l = listeners_; const auto& listener : listeners_ | std::views::values) {
+                listener->post_init(sim_);
             }
 
-            for (const auto& c : connections_) {
-                c->transferData();
+            log::info("Initialized in {:.1f}ms: entering initialization mode {:.1f}ms, connected values {:.1f}ms, exiting initialization mode {:.1f}ms",
+                milliseconds(t3 - t0), milliseconds(t1 - t0), milliseconds(t2 - t1), milliseconds(t3 - t2));
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    static double milliseconds(clock::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    // Runs f for every instance on the thread pool. Any log output is emitted in the order of the instances.
+    void for_each_instance(const std::function<void(model_instance&)>& f)
+    {
+        std::vector<log::captured_messages> messages(instances_.size());
+        std::exception_ptr error;
+        try {
+            pool_->parallel_for(instances_.size(), [&](size_t i) {
+                log::scoped_capture capture(messages[i]);
+                f(*instances_[i]);
+            });
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto& m : messages) {
+            m.flush();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Propagates connected values during initialization, in dependency order of the instances.
+    // Instances forming a cycle are updated repeatedly until their connected outputs no longer change.
+    void initialize_connected()
+    {
+        compile_plan();
+
+        const size_t n = instances_.size();
+        std::unordered_map<std::string, size_t> instanceIndex;
+        for (size_t i = 0; i < n; ++i) {
+            instanceIndex.emplace(instances_[i]->instanceName(), i);
+        }
+
+        std::vector<std::vector<size_t>> edges(n);
+        std::vector<bool> selfLoop(n, false);
+        std::vector<std::vector<const property*>> outputs(n); // connected outputs of each instance
+        std::unordered_set<const property*> seen;
+        for (const auto& c : connections_) {
+            const auto source = c->source_property();
+            const auto sink = c->sink_property();
+            if (!source || !sink) continue;
+            const auto from = instanceIndex.find(source->id().instance_name());
+            const auto to = instanceIndex.find(sink->id().instance_name());
+            if (from == instanceIndex.end() || to == instanceIndex.end()) continue;
+
+            if (seen.emplace(source).second) {
+                outputs[from->second].emplace_back(source);
             }
+            if (from->second == to->second) {
+                selfLoop[from->second] = true;
+            } else if (std::ranges::find(edges[from->second], to->second) == edges[from->second].end()) {
+                edges[from->second].emplace_back(to->second);
+            }
+        }
 
-            for (const auto& instance : instances_) {
-                instance->get_properties().apply_sets();
-                instance->get_properties().apply_gets();
+        auto update = [this](size_t i) {
+            plan_.transfer(i);
+            auto& properties = instances_[i]->get_properties();
+            properties.apply_sets();
+            properties.apply_gets();
+        };
+
+        auto snapshot = [&](const std::vector<size_t>& members) {
+            std::vector<output_value> values;
+            for (const auto i : members) {
+                for (const auto p : outputs[i]) {
+                    values.emplace_back(read_value(p));
+                }
+            }
+            return values;
+        };
+
+        // sinks outside of the simulation's instances
+        plan_.transfer(plan_.num_groups() - 1);
+
+        size_t numUpdates = 0;
+        size_t numCycles = 0;
+        size_t maxPasses = 1;
+        auto components = strongly_connected_components(edges);
+        std::ranges::reverse(components);
+        for (auto& members : components) {
+            std::ranges::sort(members);
+            if (members.size() == 1 && !selfLoop[members.front()]) {
+                update(members.front());
+                ++numUpdates;
+                continue;
             }
 
-            for (auto l = listeners_; const auto& listener : listeners_ | std::views::values) {
-                listener->post_init(sim_);
+            ++numCycles;
+            auto previous = snapshot(members);
+            size_t passes = 0;
+            bool converged = false;
+            while (!converged && passes < maxInitIterations_) {
+                for (const auto i : members) {
+                    update(i);
+                }
+                ++passes;
+                auto current = snapshot(members);
+                converged = std::ranges::equal(previous, current, [this](const auto& a, const auto& b) {
+                    return !changed(a, b, initTolerance_);
+                });
+                previous = std::move(current);
             }
+            numUpdates += passes * members.size();
+            maxPasses = std::max(maxPasses, passes);
+
+            if (converged) {
+                log::debug("Initialization of a cycle of {} instances converged after {} passes", members.size(), passes);
+            } else {
+                log::warn("Initialization of a cycle of {} instances (including {}) did not converge within {} passes",
+                    members.size(), instances_[members.front()]->instanceName(), maxInitIterations_);
+            }
+        }
 
-            log::debug("Initialized.");
+        if (numCycles == 0) {
+            log::info("Initialized {} instances in a single ordered pass", n);
+        } else {
+            log::info("Initialized {} instances with {} updates, {} cycles needed up to {} passes",
+                n, numUpdates, numCycles, maxPasses);
         }
     }
 
@@ -113,14 +455,15 @@ struct simulation::Impl
 
             newT = algorithm_->step(currentTime_);
 
-            for (const auto& c : connections_) {
-                c->transferData();
-            }
+            transfer_data(algorithm_->pending_consumers());
 
-            std::for_each(std::execution::par, instances_.begin(), instances_.end(), [](auto& instance) {
-                instance->get_properties().apply_sets();
-                instance->get_properties().apply_gets();
-            });
+            if (!algorithm_->updates_all_instances()) {
+                pool_->parallel_for(instances_.size(), [this](size_t i) {
+                    auto& properties = instances_[i]->get_properties();
+                    properties.apply_sets();
+                    properties.apply_gets();
+                });
+            }
 
             lastDelta_ = newT - currentTime_;
             currentTime_ = newT;
@@ -165,6 +508,32 @@ bool simulation::terminated() const
     return pimpl_->terminated_;
 }
 
+void simulation::set_num_threads(size_t numThreads, bool pinThreads)
+{
+    const bool pinningChanged = pinThreads != pimpl_->pinThreads_;
+    pimpl_->numThreads_ = numThreads;
+    pimpl_->pinThreads_ = pinThreads;
+    if (pinningChanged) {
+        pimpl_->algorithm_->set_thread_pool(nullptr);
+        pimpl_->pool_.reset();
+    }
+    if (pimpl_->initialized_) {
+        pimpl_->create_thread_pool();
+    }
+}
+
+void simulation::set_init_tolerance(double tolerance, size_t maxIterations)
+{
+    if (tolerance < 0) {
+        throw std::invalid_argument("tolerance must not be negative");
+    }
+    if (maxIterations == 0) {
+        throw std::invalid_argument("maxIterations must be at least 1");
+    }
+    pimpl_->initTolerance_ = tolerance;
+    pimpl_->maxInitIterations_ = maxIterations;
+}
+
 void simulation::init(std::optional<double> startTime, const std::optional<std::string>& parameterSet)
 {
     pimpl_->init(startTime, parameterSet);
@@ -205,6 +574,8 @@ void simulation::terminate()
             instance->terminate();
         }
 
+        pimpl_->algorithm_->terminate();
+
         for (auto l = pimpl_->listeners_; const auto& listener : l | std::views::values) {
             listener->post_terminate(*this);
         }
@@ -247,12 +618,8 @@ bool simulation::remove_listener(const std::string& name)
 
 model_instance* simulation::get_instance(const std::string& name) const
 {
-    for (const auto& instance : pimpl_->instances_) {
-        if (instance->instanceName() == name) {
-            return instance.get();
-        }
-    }
-    return nullptr;
+    const auto it = pimpl_->instanceIndex_.find(name);
+    return it == pimpl_->instanceIndex_.end() ? nullptr : it->second;
 }
 
 void simulation::add_slave(std::unique_ptr<model_instance> instance)
@@ -262,6 +629,7 @@ void simulation::add_slave(std::unique_ptr<model_instance> instance)
     }
 
     pimpl_->instances_.emplace_back(std::move(instance));
+    pimpl_->index_instance(pimpl_->instances_.back().get());
     pimpl_->algorithm_->model_instance_added(pimpl_->instances_.back().get());
 }
 
@@ -272,8 +640,7 @@ real_connection* simulation::make_real_connection(const variable_identifier& sou
     const auto p2 = get_real_property(sink);
     if (!p2) throw std::runtime_error("No such real property: " + sink.str());
 
-    pimpl_->connections_.emplace_back(std::make_unique<real_connection>(p1, p2));
-    return dynamic_cast<real_connection*>(pimpl_->connections_.back().get());
+    return pimpl_->add_connection(std::make_unique<real_connection>(p1, p2));
 }
 
 int_connection* simulation::make_int_connection(const variable_identifier& source, const variable_identifier& sink)
@@ -283,8 +650,7 @@ int_connection* simulation::make_int_connection(const variable_identifier& sourc
     const auto p2 = get_int_property(sink);
     if (!p2) throw std::runtime_error("No such int property: " + sink.str());
 
-    pimpl_->connections_.emplace_back(std::make_unique<int_connection>(p1, p2));
-    return dynamic_cast<int_connection*>(pimpl_->connections_.back().get());
+    return pimpl_->add_connection(std::make_unique<int_connection>(p1, p2));
 }
 
 bool_connection* simulation::make_bool_connection(const variable_identifier& source, const variable_identifier& sink)
@@ -294,8 +660,7 @@ bool_connection* simulation::make_bool_connection(const variable_identifier& sou
     const auto p2 = get_bool_property(sink);
     if (!p2) throw std::runtime_error("No such bool property: " + sink.str());
 
-    pimpl_->connections_.emplace_back(std::make_unique<bool_connection>(p1, p2));
-    return dynamic_cast<bool_connection*>(pimpl_->connections_.back().get());
+    return pimpl_->add_connection(std::make_unique<bool_connection>(p1, p2));
 }
 
 string_connection* simulation::make_string_connection(const variable_identifier& source, const variable_identifier& sink)
@@ -305,63 +670,121 @@ string_connection* simulation::make_string_connection(const variable_identifier&
     const auto p2 = get_string_property(sink);
     if (!p2) throw std::runtime_error("No such string property: " + sink.str());
 
-    pimpl_->connections_.emplace_back(std::make_unique<string_connection>(p1, p2));
-    return dynamic_cast<string_connection*>(pimpl_->connections_.back().get());
+    return pimpl_->add_connection(std::make_unique<string_connection>(p1, p2));
+}
+
+int64_connection* simulation::make_int64_connection(const variable_identifier& source, const variable_identifier& sink)
+{
+    const auto p1 = get_int64_property(source);
+    if (!p1) throw std::runtime_error("No such int64 property: " + source.str());
+    const auto p2 = get_int64_property(sink);
+    if (!p2) throw std::runtime_error("No such int64 property: " + sink.str());
+
+    return pimpl_->add_connection(std::make_unique<int64_connection>(p1, p2));
+}
+
+uint64_connection* simulation::make_uint64_connection(const variable_identifier& source, const variable_identifier& sink)
+{
+    const auto p1 = get_uint64_property(source);
+    if (!p1) throw std::runtime_error("No such uint64 property: " + source.str());
+    const auto p2 = get_uint64_property(sink);
+    if (!p2) throw std::runtime_error("No such uint64 property: " + sink.str());
+
+    return pimpl_->add_connection(std::make_unique<uint64_connection>(p1, p2));
+}
+
+float32_connection* simulation::make_float32_connection(const variable_identifier& source, const variable_identifier& sink)
+{
+    const auto p1 = get_float32_property(source);
+    if (!p1) throw std::runtime_error("No such float32 property: " + source.str());
+    const auto p2 = get_float32_property(sink);
+    if (!p2) throw std::runtime_error("No such float32 property: " + sink.str());
+
+    return pimpl_->add_connection(std::make_unique<float32_connection>(p1, p2));
 }
 
 property_t<double>* simulation::get_real_property(const variable_identifier& identifier) const
 {
-    for (const auto& instance : pimpl_->instances_) {
-        if (instance->instanceName() == identifier.instance_name()) {
-            const auto p = instance->get_properties().get_real_property(identifier.variable_name());
-            if (p) return p;
-        }
-    }
-    return nullptr;
+    return pimpl_->find_property<double>(identifier);
 }
 
 property_t<int>* simulation::get_int_property(const variable_identifier& identifier) const
 {
-    for (const auto& instance : pimpl_->instances_) {
-        if (instance->instanceName() == identifier.instance_name()) {
-            const auto p = instance->get_properties().get_int_property(identifier.variable_name());
-            if (p) return p;
-        }
-    }
-    return nullptr;
+    return pimpl_->find_property<int>(identifier);
 }
 
 property_t<std::string>* simulation::get_string_property(const variable_identifier& identifier) const
 {
-    for (const auto& instance : pimpl_->instances_) {
-        if (instance->instanceName() == identifier.instance_name()) {
-            auto p = instance->get_properties().get_string_property(identifier.variable_name());
-            if (p) return p;
-        }
-    }
-    return nullptr;
+    return pimpl_->find_property<std::string>(identifier);
 }
 
 property_t<std::vector<uint8_t>>* simulation::get_binary_property(const variable_identifier& identifier) const
 {
-    for (const auto& instance : pimpl_->instances_) {
-        if (instance->instanceName() == identifier.instance_name()) {
-            auto p = instance->get_properties().get_binary_property(identifier.variable_name());
-            if (p) return p;
-        }
-    }
-    return nullptr;
+    return pimpl_->find_property<std::vector<uint8_t>>(identifier);
 }
 
 property_t<bool>* simulation::get_bool_property(const variable_identifier& identifier) const
 {
-    for (const auto& instance : pimpl_->instances_) {
-        if (instance->instanceName() == identifier.instance_name()) {
-            const auto p = instance->get_properties().get_bool_property(identifier.variable_name());
-            if (p) return p;
-        }
+    return pimpl_->find_property<bool>(identifier);
+}
+
+property_t<int64_t>* simulation::get_int64_property(const variable_identifier& identifier) const
+{
+    return pimpl_->find_property<int64_t>(identifier);
+}
+
+property_t<uint64_t>* simulation::get_uint64_property(const variable_identifier& identifier) const
+{
+    return pimpl_->find_property<uint64_t>(identifier);
+}
+
+property_t<float>* simulation::get_float32_property(const variable_identifier& identifier) const
+{
+    return pimpl_->find_property<float>(identifier);
+}
+
+variable_handle simulation::resolve(const variable_identifier& identifier) const
+{
+    const auto it = pimpl_->variableIndex_.find(identifier);
+    if (it == pimpl_->variableIndex_.end()) {
+        throw std::runtime_error("No such variable: " + identifier.str());
     }
-    return nullptr;
+    return variable_handle(it->second);
+}
+
+template<class T>
+T simulation::get(variable_handle handle) const
+{
+    return pimpl_->resolved<T>(handle)->get_value();
+}
+
+template<class T>
+void simulation::set(variable_handle handle, const T& value)
+{
+    pimpl_->resolved<T>(handle)->set_value(value);
+}
+
+template double simulation::get<double>(variable_handle) const;
+template int simulation::get<int>(variable_handle) const;
+template bool simulation::get<bool>(variable_handle) const;
+template std::string simulation::get<std::string>(variable_handle) const;
+template std::vector<uint8_t> simulation::get<std::vector<uint8_t>>(variable_handle) const;
+template int64_t simulation::get<int64_t>(variable_handle) const;
+template uint64_t simulation::get<uint64_t>(variable_handle) const;
+template float simulation::get<float>(variable_handle) const;
+
+template void simulation::set<double>(variable_handle, const double&);
+template void simulation::set<int>(variable_handle, const int&);
+template void simulation::set<bool>(variable_handle, const bool&);
+template void simulation::set<std::string>(variable_handle, const std::string&);
+template void simulation::set<std::vector<uint8_t>>(variable_handle, const std::vector<uint8_t>&);
+template void simulation::set<int64_t>(variable_handle, const int64_t&);
+template void simulation::set<uint64_t>(variable_handle, const uint64_t&);
+template void simulation::set<float>(variable_handle, const float&);
+
+const value_store& simulation::get_value_store() const
+{
+    return pimpl_->store_;
 }
 
 const std::vector<std::unique_ptr<model_instance>>& simulation::get_instances() const
@@ -255,9 +255,7 @@ struct SystemStructureDescription::Impl
         } else {
             tmp_ = std::make_unique<temp_dir>("ssp");
             dir_ = tmp_->path();
-            if (!unzip(path, dir_)) {
-                throw std::runtime_error("Failed to unzip contents..");
-            }
+            unzip(path, dir_);
         }
 
         pugi::xml_parse_result result = doc_.load_file(std::filesystem::path(dir_ / "SystemStructure.ssd").c_str());
@@ -1,9 +1,14 @@
 
 #include "ecos/structure/simulation_structure.hpp"
 
+#include "ecos/logger/logger.hpp"
+#include "ecos/util/thread_pool.hpp"
 #include "ecos/variable_identifier.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <ranges>
+#include <thread>
 #include <utility>
 
 using namespace ecos;
@@ -61,11 +66,44 @@ void simulation_structure::add_parameter_set(const std::string& name, const para
 
 std::unique_ptr<simulation> simulation_structure::load(std::unique_ptr<algorithm> algorithm)
 {
+    const auto start = std::chrono::steady_clock::now();
+
+    // instantiation is dominated by work on the model side (e.g. loading shared libraries and reading files),
+    // so models are instantiated concurrently. Their log output is kept in a fixed order.
+    std::vector<const decltype(models_)::value_type*> entries;
+    for (const auto& entry : models_) {
+        entries.emplace_back(&entry);
+    }
+    std::vector<std::unique_ptr<model_instance>> created(entries.size());
+    std::vector<log::captured_messages> messages(entries.size());
+    {
+        const auto numThreads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), std::max<size_t>(1, entries.size()));
+        thread_pool pool(numThreads);
+        try {
+            pool.parallel_for(entries.size(), [&](size_t i) {
+                log::scoped_capture capture(messages[i]);
+                const auto& [name, model] = *entries[i];
+                created[i] = model.first->instantiate(name, model.second);
+            });
+        } catch (...) {
+            for (auto& m : messages) {
+                m.flush();
+            }
+            throw;
+        }
+    }
+    for (auto& m : messages) {
+        m.flush();
+    }
+
     std::unordered_map<std::string, std::unique_ptr<model_instance>> instances;
-    for (const auto& [name, model] : models_) {
-        instances.emplace(name, model.first->instantiate(name, model.second));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        instances.emplace(entries[i]->first, std::move(created[i]));
     }
 
+    log::info("Instantiated {} models in {:.1f}ms", instances.size(),
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
     for (const auto& [parameterSetName, map] : parameterSets) {
         for (const auto& [v, value] : map) {
             instances[v.instance_name()]->add_parameterset_entry(parameterSetName, v.variable_name(), value);
@@ -0,0 +1,322 @@
+
+#include "ecos/util/thread_pool.hpp"
+
+#include "ecos/logger/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    include <immintrin.h>
+#    define ECOS_CPU_RELAX() _mm_pause()
+#else
+#    define ECOS_CPU_RELAX() std::this_thread::yield()
+#endif
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#elif defined(__linux__)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+using namespace ecos;
+
+namespace
+{
+
+// number of busy polls, after which a waiting thread yields for a while before parking.
+// Yielding keeps an oversubscribed machine responsive.
+constexpr int spinCount = 64;
+constexpr int yieldCount = 1024;
+
+void backoff(int& spins)
+{
+    if (spins < spinCount) {
+        ECOS_CPU_RELAX();
+    } else {
+        std::this_thread::yield();
+    }
+    ++spins;
+}
+
+// [begin, end) range of task indices, packed into a single word so that it can be updated atomically
+constexpr uint64_t pack(uint32_t begin, uint32_t end)
+{
+    return static_cast<uint64_t>(end) << 32 | begin;
+}
+
+constexpr uint32_t begin_of(uint64_t range)
+{
+    return static_cast<uint32_t>(range);
+}
+
+constexpr uint32_t end_of(uint64_t range)
+{
+    return static_cast<uint32_t>(range >> 32);
+}
+
+struct alignas(64) task_queue
+{
+    std::atomic<uint64_t> range{0};
+
+    // owner side, takes from the front
+    bool pop(uint32_t& task)
+    {
+        uint64_t r = range.load(std::memory_order_relaxed);
+        while (begin_of(r) < end_of(r)) {
+            if (range.compare_exchange_weak(r, pack(begin_of(r) + 1, end_of(r)), std::memory_order_acq_rel)) {
+                task = begin_of(r);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // thief side, takes from the back
+    bool steal(uint32_t& task)
+    {
+        uint64_t r = range.load(std::memory_order_relaxed);
+        while (begin_of(r) < end_of(r)) {
+            if (range.compare_exchange_weak(r, pack(begin_of(r), end_of(r) - 1), std::memory_order_acq_rel)) {
+                task = end_of(r) - 1;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+thread_local size_t currentThreadIndex = 0;
+
+void pin_to_core(std::thread& thread, size_t core)
+{
+    const auto numCores = std::max(1u, std::thread::hardware_concurrency());
+    core %= numCores;
+#ifdef _WIN32
+    if (core < sizeof(DWORD_PTR) * 8) {
+        SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), static_cast<DWORD_PTR>(1) << core);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set) != 0) {
+        log::warn("Unable to pin worker thread to core {}", core);
+    }
+#else
+    log::warn("Thread pinning is not supported on this platform");
+#endif
+}
+
+} // namespace
+
+class thread_pool::impl
+{
+
+public:
+    impl(size_t numThreads, bool pinThreads)
+        : numThreads_(numThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : numThreads)
+        , queues_(std::make_unique<task_queue[]>(numThreads_))
+    {
+        workers_.reserve(numThreads_ - 1);
+        for (size_t i = 1; i < numThreads_; ++i) {
+            workers_.emplace_back([this, i] {
+                run(i);
+            });
+            if (pinThreads) {
+                pin_to_core(workers_.back(), i);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t num_threads() const
+    {
+        return numThreads_;
+    }
+
+    void parallel_for(size_t numTasks, const std::function<void(size_t)>& f)
+    {
+        if (workers_.empty() || numTasks <= 1) {
+            for (size_t i = 0; i < numTasks; ++i) {
+                f(i);
+            }
+            return;
+        }
+
+        const size_t chunk = numTasks / numThreads_;
+        const size_t remainder = numTasks % numThreads_;
+        size_t begin = 0;
+        for (size_t i = 0; i < numThreads_; ++i) {
+            const size_t end = begin + chunk + (i < remainder ? 1 : 0);
+            queues_[i].range.store(pack(static_cast<uint32_t>(begin), static_cast<uint32_t>(end)), std::memory_order_relaxed);
+            begin = end;
+        }
+
+        dispatch(f);
+    }
+
+    void parallel_for(std::span<const size_t> offsets, const std::function<void(size_t)>& f)
+    {
+        if (offsets.size() != numThreads_ + 1) {
+            throw std::invalid_argument("Expected " + std::to_string(numThreads_ + 1) + " offsets, got " + std::to_string(offsets.size()));
+        }
+        if (workers_.empty()) {
+            for (size_t i = offsets.front(); i < offsets.back(); ++i) {
+                f(i);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < numThreads_; ++i) {
+            queues_[i].range.store(pack(static_cast<uint32_t>(offsets[i]), static_cast<uint32_t>(offsets[i + 1])), std::memory_order_relaxed);
+        }
+
+        dispatch(f);
+    }
+
+    ~impl()
+    {
+        stop_.store(true, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+private:
+    size_t numThreads_;
+    std::unique_ptr<task_queue[]> queues_;
+    std::vector<std::thread> workers_;
+
+    const std::function<void(size_t)>* task_{nullptr};
+    std::exception_ptr error_;
+    std::mutex errorMutex_;
+
+    alignas(64) std::atomic<uint64_t> generation_{0};
+    alignas(64) std::atomic<uint32_t> finished_{0};
+    std::atomic<bool> stop_{false};
+
+    // runs the job described by the task queues, which must have been filled in
+    void dispatch(const std::function<void(size_t)>& f)
+    {
+        task_ = &f;
+        error_ = nullptr;
+        finished_.store(0, std::memory_order_relaxed);
+
+        // fork
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+
+        execute(0);
+
+        // join, every worker checks in so that no one is still touching this job when the next one is set up
+        const auto numWorkers = static_cast<uint32_t>(workers_.size());
+        int spins = 0;
+        for (uint32_t done = finished_.load(std::memory_order_acquire); done != numWorkers; done = finished_.load(std::memory_order_acquire)) {
+            if (spins < spinCount + yieldCount) {
+                backoff(spins);
+            } else {
+                finished_.wait(done, std::memory_order_acquire);
+            }
+        }
+
+        task_ = nullptr;
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    void run(size_t self)
+    {
+        currentThreadIndex = self;
+
+        uint64_t seen = 0;
+        while (true) {
+            int spins = 0;
+            uint64_t current = generation_.load(std::memory_order_acquire);
+            while (current == seen) {
+                if (spins < spinCount + yieldCount) {
+                    backoff(spins);
+                } else {
+                    generation_.wait(seen, std::memory_order_acquire);
+                }
+                current = generation_.load(std::memory_order_acquire);
+            }
+            seen = current;
+
+            if (stop_.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            execute(self);
+
+            if (finished_.fetch_add(1, std::memory_order_acq_rel) + 1 == workers_.size()) {
+                finished_.notify_one();
+            }
+        }
+    }
+
+    void execute(size_t self)
+    {
+        uint32_t task;
+        while (queues_[self].pop(task)) {
+            invoke(task);
+        }
+        for (size_t i = 1; i < numThreads_; ++i) {
+            auto& victim = queues_[(self + i) % numThreads_];
+            while (victim.steal(task)) {
+                invoke(task);
+            }
+        }
+    }
+
+    void invoke(uint32_t task)
+    {
+        try {
+            (*task_)(task);
+        } catch (...) {
+            std::lock_guard lock(errorMutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+};
+
+thread_pool::thread_pool(size_t numThreads, bool pinThreads)
+    : pimpl_(std::make_unique<impl>(numThreads, pinThreads))
+{ }
+
+size_t thread_pool::num_threads() const
+{
+    return pimpl_->num_threads();
+}
+
+void thread_pool::parallel_for(size_t numTasks, const std::function<void(size_t)>& f)
+{
+    pimpl_->parallel_for(numTasks, f);
+}
+
+void thread_pool::parallel_for(std::span<const size_t> offsets, const std::function<void(size_t)>& f)
+{
+    pimpl_->parallel_for(offsets, f);
+}
+
+size_t thread_pool::current_thread_index()
+{
+    return currentThreadIndex;
+}
+
+thread_pool::~thread_pool() = default;
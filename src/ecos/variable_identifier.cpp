@@ -0,0 +1,85 @@
+#include "ecos/variable_identifier.hpp"
+
+#include <array>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+using namespace ecos;
+
+namespace
+{
+
+// Names are stored in chunks which are never moved or released, such that names can be read without locking
+// while others are being added. Each chunk is twice the size of the previous one, so the table grows without bound
+// (short of running out of 32-bit ids) while holding a fixed number of chunk pointers.
+constexpr size_t firstChunkSize = 1024;
+constexpr size_t numChunks = 23; // firstChunkSize * (2^23 - 1) exceeds the 2^32 ids available
+
+// The chunk holding an id, and its offset within that chunk
+std::pair<size_t, size_t> locate(uint32_t id)
+{
+    const uint64_t v = uint64_t{id} + firstChunkSize;
+    const auto chunk = static_cast<size_t>(std::bit_width(v) - std::bit_width(firstChunkSize));
+    return {chunk, static_cast<size_t>(v - (uint64_t{firstChunkSize} << chunk))};
+}
+
+class name_table
+{
+
+public:
+    uint32_t intern(std::string_view name)
+    {
+        std::lock_guard lock(mutex_);
+        if (const auto it = ids_.find(name); it != ids_.end()) {
+            return it->second;
+        }
+
+        if (size_ > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Exceeded the maximum number of interned variable names");
+        }
+        const auto id = static_cast<uint32_t>(size_);
+        const auto [chunk, offset] = locate(id);
+        if (!chunks_[chunk]) {
+            chunks_[chunk] = std::make_unique<std::string[]>(firstChunkSize << chunk);
+        }
+        auto& str = chunks_[chunk][offset];
+        str = name;
+        ids_.emplace(str, id);
+        ++size_;
+        return id;
+    }
+
+    const std::string& name(uint32_t id) const
+    {
+        const auto [chunk, offset] = locate(id);
+        return chunks_[chunk][offset];
+    }
+
+private:
+    std::mutex mutex_;
+    uint64_t size_{0};
+    std::array<std::unique_ptr<std::string[]>, numChunks> chunks_;
+    std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+name_table& names()
+{
+    static name_table table;
+    return table;
+}
+
+} // namespace
+
+uint32_t variable_identifier::intern(std::string_view name)
+{
+    return names().intern(name);
+}
+
+const std::string& variable_identifier::name(uint32_t id)
+{
+    return names().name(id);
+}
@@ -4,8 +4,12 @@
 
 #include "slave.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
-#include <set>
+#include <span>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -19,7 +23,59 @@ public:
     buffered_slave(std::unique_ptr<slave> instance)
         : slave(instance->instanceName)
         , slave_{std::move(instance)}
-    { }
+    {
+        const auto& md = slave_->get_model_description();
+        for (const auto& v : md.variables()) {
+            // aliases share the slot of the first variable declared with their value reference
+            if (md.get_by_vr(v.typeAttributes.index(), v.vr) != &v) continue;
+
+            if (v.is_integer()) {
+                integers_.add(v);
+            } else if (v.is_real()) {
+                reals_.add(v);
+            } else if (v.is_string()) {
+                strings_.add(v);
+            } else if (v.is_boolean()) {
+                booleans_.add(v);
+            } else if (v.is_binary()) {
+                binaries_.add(v);
+            } else if (v.is_int64()) {
+                int64s_.add(v);
+            } else if (v.is_uint64()) {
+                uint64s_.add(v);
+            } else if (v.is_float32()) {
+                float32s_.add(v);
+            }
+        }
+
+        integers_.build();
+        reals_.build();
+        strings_.build();
+        booleans_.build();
+        binaries_.build();
+        int64s_.build();
+        uint64s_.build();
+        float32s_.build();
+
+        integerValues_.resize(num_integers());
+        realValues_.resize(num_reals());
+        stringValues_.resize(num_strings());
+        booleanValues_.resize(num_booleans());
+        binaryValues_.resize(binaries_.vrs.size());
+        int64Values_.resize(num_int64s());
+        uint64Values_.resize(num_uint64s());
+        float32Values_.resize(num_float32s());
+
+        integerBuffer_ = integerValues_.data();
+        realBuffer_ = realValues_.data();
+        stringBuffer_ = stringValues_.data();
+        booleanBuffer_ = booleanValues_.data();
+        int64Buffer_ = int64Values_.data();
+        uint64Buffer_ = uint64Values_.data();
+        float32Buffer_ = float32Values_.data();
+
+        invalidate_sets();
+    }
 
     slave* get()
     {
@@ -46,6 +102,8 @@ public:
     bool exit_initialization_mode() override
     {
         bool status = slave_->exit_initialization_mode();
+        // constants and fixed parameters are final from here on, and fetched one last time
+        finalizeStatics_ = true;
         return status;
     }
 
@@ -64,18 +122,47 @@ public:
         bool status = slave_->reset();
         if (status) {
             initialized = false;
+            finalizeStatics_ = false;
+            invalidate_sets();
+            integers_.restart();
+            reals_.restart();
+            strings_.restart();
+            booleans_.restart();
+            binaries_.restart();
+            int64s_.restart();
+            uint64s_.restart();
+            float32s_.restart();
         }
         return status;
     }
 
+    void* get_state() override
+    {
+        return slave_->get_state();
+    }
+
+    bool set_state(void* state) override
+    {
+        bool status = slave_->set_state(state);
+        if (status) {
+            // inputs may have been restored to other values than we last set
+            invalidate_sets();
+            if (initialized) {
+                receiveCachedGets();
+            }
+        }
+        return status;
+    }
+
+    bool free_state(void* state) override
+    {
+        return slave_->free_state(state);
+    }
+
     bool get_integer(const std::vector<value_ref>& vrs, std::vector<int>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            if (std::ranges::find(integersToFetch_, vr) == integersToFetch_.end()) {
-                mark_for_reading(get_model_description().get_by_vr<int>(vr)->name);
-            }
-            values[i] = integerGetCache_.at(vr);
+            values[i] = integerBuffer_[fresh_slot(integers_, vrs[i], "integer")];
         }
         return true;
     }
@@ -83,11 +170,7 @@ public:
     bool get_real(const std::vector<value_ref>& vrs, std::vector<double>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            if (std::ranges::find(realsToFetch_, vr) == realsToFetch_.end()) {
-                mark_for_reading(get_model_description().get_by_vr<double>(vr)->name);
-            }
-            values[i] = realGetCache_.at(vr);
+            values[i] = realBuffer_[fresh_slot(reals_, vrs[i], "real")];
         }
         return true;
     }
@@ -95,11 +178,7 @@ public:
     bool get_string(const std::vector<value_ref>& vrs, std::vector<std::string>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            if (std::ranges::find(stringsToFetch_, vr) == stringsToFetch_.end()) {
-                mark_for_reading(get_model_description().get_by_vr<std::string>(vr)->name);
-            }
-            values[i] = stringGetCache_.at(vr);
+            values[i] = stringBuffer_[fresh_slot(strings_, vrs[i], "string")];
         }
         return true;
     }
@@ -107,11 +186,7 @@ public:
     bool get_boolean(const std::vector<value_ref>& vrs, std::vector<bool>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            if (std::ranges::find(booleansToFetch_, vr) == booleansToFetch_.end()) {
-                mark_for_reading(get_model_description().get_by_vr<bool>(vr)->name);
-            }
-            values[i] = booleanGetCache_.at(vr);
+            values[i] = booleanBuffer_[fresh_slot(booleans_, vrs[i], "boolean")] != 0;
         }
         return true;
     }
@@ -119,11 +194,31 @@ public:
     bool get_binary(const std::vector<value_ref>& vrs, std::vector<std::vector<uint8_t>>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            if (std::ranges::find(bytesToFetch_, vr) == bytesToFetch_.end()) {
-                mark_for_reading(get_model_description().get_by_vr<std::vector<uint8_t>>(vr)->name);
-            }
-            values[i] = bytesGetCache_.at(vr);
+            values[i] = binaryValues_[fresh_slot(binaries_, vrs[i], "binary")];
+        }
+        return true;
+    }
+
+    bool get_int64(std::span<const value_ref> vrs, std::span<int64_t> values) override
+    {
+        for (unsigned i = 0; i < vrs.size(); i++) {
+            values[i] = int64Buffer_[fresh_slot(int64s_, vrs[i], "int64")];
+        }
+        return true;
+    }
+
+    bool get_uint64(std::span<const value_ref> vrs, std::span<uint64_t> values) override
+    {
+        for (unsigned i = 0; i < vrs.size(); i++) {
+            values[i] = uint64Buffer_[fresh_slot(uint64s_, vrs[i], "uint64")];
+        }
+        return true;
+    }
+
+    bool get_float32(std::span<const value_ref> vrs, std::span<float> values) override
+    {
+        for (unsigned i = 0; i < vrs.size(); i++) {
+            values[i] = float32Buffer_[fresh_slot(float32s_, vrs[i], "float32")];
         }
         return true;
     }
@@ -131,8 +226,7 @@ public:
     bool set_integer(const std::vector<value_ref>& vrs, const std::vector<int>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            integerSetCache_[vr] = values[i];
+            set_integer_at(integer_slot(vrs[i]), values[i]);
         }
         return true;
     }
@@ -140,8 +234,7 @@ public:
     bool set_real(const std::vector<value_ref>& vrs, const std::vector<double>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            realSetCache_[vr] = values[i];
+            set_real_at(real_slot(vrs[i]), values[i]);
         }
         return true;
     }
@@ -149,8 +242,7 @@ public:
     bool set_string(const std::vector<value_ref>& vrs, const std::vector<std::string>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            stringSetCache_[vr] = values[i];
+            set_string_at(string_slot(vrs[i]), values[i]);
         }
         return true;
     }
@@ -158,8 +250,7 @@ public:
     bool set_boolean(const std::vector<value_ref>& vrs, const std::vector<bool>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            boolSetCache_[vr] = values[i];
+            set_boolean_at(boolean_slot(vrs[i]), values[i]);
         }
         return true;
     }
@@ -167,158 +258,230 @@ public:
     bool set_binary(const std::vector<value_ref>& vrs, const std::vector<std::vector<uint8_t>>& values) override
     {
         for (unsigned i = 0; i < vrs.size(); i++) {
-            const value_ref vr = vrs[i];
-            bytesSetCache_[vr] = values[i];
+            binaries_.queue(slot_of(binaries_, vrs[i], "binary"), values[i]);
         }
         return true;
     }
 
-    void transferCachedSets()
+    bool set_int64(std::span<const value_ref> vrs, std::span<const int64_t> values) override
     {
-        if (!integerSetCache_.empty()) {
-            std::vector<value_ref> vrs;
-            std::vector<int> values;
-            for (const auto& [vr, value] : integerSetCache_) {
-                vrs.emplace_back(vr);
-                values.emplace_back(value);
-            }
-            slave_->set_integer(vrs, values);
-            integerSetCache_.clear();
-        }
-        if (!realSetCache_.empty()) {
-            std::vector<value_ref> vrs;
-            std::vector<double> values;
-            for (const auto& [vr, value] : realSetCache_) {
-                vrs.emplace_back(vr);
-                values.emplace_back(value);
-            }
-            slave_->set_real(vrs, values);
-            realSetCache_.clear();
-        }
-        if (!stringSetCache_.empty()) {
-            std::vector<value_ref> vrs;
-            std::vector<std::string> values;
-            for (const auto& [vr, value] : stringSetCache_) {
-                vrs.emplace_back(vr);
-                values.emplace_back(value);
-            }
-            slave_->set_string(vrs, values);
-            stringSetCache_.clear();
-        }
-        if (!boolSetCache_.empty()) {
-            std::vector<value_ref> vrs;
-            std::vector<bool> values;
-            for (const auto& [vr, value] : boolSetCache_) {
-                vrs.emplace_back(vr);
-                values.emplace_back(value);
-            }
-            slave_->set_boolean(vrs, values);
-            boolSetCache_.clear();
-        }
-        if (!bytesSetCache_.empty()) {
-            std::vector<value_ref> vrs;
-            std::vector<std::vector<uint8_t>> values;
-            for (const auto& [vr, value] : bytesSetCache_) {
-                vrs.emplace_back(vr);
-                values.emplace_back(value);
-            }
-            slave_->set_binary(vrs, values);
-            bytesSetCache_.clear();
+        for (unsigned i = 0; i < vrs.size(); i++) {
+            set_int64_at(int64_slot(vrs[i]), values[i]);
+        }
+        return true;
+    }
+
+    bool set_uint64(std::span<const value_ref> vrs, std::span<const uint64_t> values) override
+    {
+        for (unsigned i = 0; i < vrs.size(); i++) {
+            set_uint64_at(uint64_slot(vrs[i]), values[i]);
         }
+        return true;
     }
 
+    bool set_float32(std::span<const value_ref> vrs, std::span<const float> values) override
+    {
+        for (unsigned i = 0; i < vrs.size(); i++) {
+            set_float32_at(float32_slot(vrs[i]), values[i]);
+        }
+        return true;
+    }
+
+    void transferCachedSets()
+    {
+        transfer(integers_, integerBit);
+        transfer(reals_, realBit);
+        transfer(strings_, stringBit);
+        transfer(booleans_, booleanBit);
+        transfer(binaries_, 0);
+        transfer(int64s_, int64Bit);
+        transfer(uint64s_, uint64Bit);
+        transfer(float32s_, float32Bit);
+        skippedTypes_ = 0;
+    }
+
+    // Fetches the values of subscribed variables. Values of any other variable that has been read are
+    // outdated from here on, and fetched together on the next read of any of them.
     void receiveCachedGets()
     {
-        if (!integersToFetch_.empty()) {
-            __integerGetCache_.resize(integersToFetch_.size());
-            slave_->get_integer(integersToFetch_, __integerGetCache_);
+        ++generation_;
+        fetch(integers_, integers_.eager, integerBuffer_);
+        fetch(reals_, reals_.eager, realBuffer_);
+        fetch(strings_, strings_.eager, stringBuffer_);
+        fetch(booleans_, booleans_.eager, booleanBuffer_);
+        fetch(binaries_, binaries_.eager, binaryValues_.data());
+        fetch(int64s_, int64s_.eager, int64Buffer_);
+        fetch(uint64s_, uint64s_.eager, uint64Buffer_);
+        fetch(float32s_, float32s_.eager, float32Buffer_);
+    }
 
-            integerGetCache_.clear();
-            for (unsigned i = 0; i < integersToFetch_.size(); i++) {
-                const value_ref vr = integersToFetch_[i];
-                integerGetCache_[vr] = __integerGetCache_[i];
-            }
+    // Number of distinct (by value reference) variables of each type held by this slave.
+    [[nodiscard]] size_t num_integers() const { return integers_.vrs.size(); }
+    [[nodiscard]] size_t num_reals() const { return reals_.vrs.size(); }
+    [[nodiscard]] size_t num_strings() const { return strings_.vrs.size(); }
+    [[nodiscard]] size_t num_booleans() const { return booleans_.vrs.size(); }
+    [[nodiscard]] size_t num_int64s() const { return int64s_.vrs.size(); }
+    [[nodiscard]] size_t num_uint64s() const { return uint64s_.vrs.size(); }
+    [[nodiscard]] size_t num_float32s() const { return float32s_.vrs.size(); }
+
+    // Slot of a variable within the value buffers of its type.
+    [[nodiscard]] size_t integer_slot(value_ref vr) const { return slot_of(integers_, vr, "integer"); }
+    [[nodiscard]] size_t real_slot(value_ref vr) const { return slot_of(reals_, vr, "real"); }
+    [[nodiscard]] size_t string_slot(value_ref vr) const { return slot_of(strings_, vr, "string"); }
+    [[nodiscard]] size_t boolean_slot(value_ref vr) const { return slot_of(booleans_, vr, "boolean"); }
+    [[nodiscard]] size_t int64_slot(value_ref vr) const { return slot_of(int64s_, vr, "int64"); }
+    [[nodiscard]] size_t uint64_slot(value_ref vr) const { return slot_of(uint64s_, vr, "uint64"); }
+    [[nodiscard]] size_t float32_slot(value_ref vr) const { return slot_of(float32s_, vr, "float32"); }
+
+    // Current values by slot, e.g. for direct reads. The buffers change when attach_buffers is called.
+    [[nodiscard]] int32_t* integer_values() { return integerBuffer_; }
+    [[nodiscard]] double* real_values() { return realBuffer_; }
+    [[nodiscard]] std::string* string_values() { return stringBuffer_; }
+    [[nodiscard]] uint8_t* boolean_values() { return booleanBuffer_; }
+    [[nodiscard]] int64_t* int64_values() { return int64Buffer_; }
+    [[nodiscard]] uint64_t* uint64_values() { return uint64Buffer_; }
+    [[nodiscard]] float* float32_values() { return float32Buffer_; }
+
+    // Counter of calls to receiveCachedGets. Values fetched at an earlier generation are outdated.
+    [[nodiscard]] const uint64_t* generation() const { return &generation_; }
+
+    // Generation at which the value of each slot was last fetched, final values are never outdated.
+    [[nodiscard]] const uint64_t* integer_fetched_at() const { return integers_.fetchedAt.data(); }
+    [[nodiscard]] const uint64_t* real_fetched_at() const { return reals_.fetchedAt.data(); }
+    [[nodiscard]] const uint64_t* string_fetched_at() const { return strings_.fetchedAt.data(); }
+    [[nodiscard]] const uint64_t* boolean_fetched_at() const { return booleans_.fetchedAt.data(); }
+    [[nodiscard]] const uint64_t* int64_fetched_at() const { return int64s_.fetchedAt.data(); }
+    [[nodiscard]] const uint64_t* uint64_fetched_at() const { return uint64s_.fetchedAt.data(); }
+    [[nodiscard]] const uint64_t* float32_fetched_at() const { return float32s_.fetchedAt.data(); }
+
+    // Fetches the value of a slot with every call to receiveCachedGets, for variables read after every step.
+    void subscribe_integer(size_t slot) { subscribe(integers_, slot, integerBuffer_); }
+    void subscribe_real(size_t slot) { subscribe(reals_, slot, realBuffer_); }
+    void subscribe_string(size_t slot) { subscribe(strings_, slot, stringBuffer_); }
+    void subscribe_boolean(size_t slot) { subscribe(booleans_, slot, booleanBuffer_); }
+    void subscribe_int64(size_t slot) { subscribe(int64s_, slot, int64Buffer_); }
+    void subscribe_uint64(size_t slot) { subscribe(uint64s_, slot, uint64Buffer_); }
+    void subscribe_float32(size_t slot) { subscribe(float32s_, slot, float32Buffer_); }
+
+    // Brings the value of an outdated slot up to date, along with other outdated values read before.
+    void refresh_integer(size_t slot) { refresh(integers_, slot, integerBuffer_); }
+    void refresh_real(size_t slot) { refresh(reals_, slot, realBuffer_); }
+    void refresh_string(size_t slot) { refresh(strings_, slot, stringBuffer_); }
+    void refresh_boolean(size_t slot) { refresh(booleans_, slot, booleanBuffer_); }
+    void refresh_int64(size_t slot) { refresh(int64s_, slot, int64Buffer_); }
+    void refresh_uint64(size_t slot) { refresh(uint64s_, slot, uint64Buffer_); }
+    void refresh_float32(size_t slot) { refresh(float32s_, slot, float32Buffer_); }
+
+    // Sets the variable of a slot, equivalent to set_xxx without the lookup of the slot.
+    void set_integer_at(size_t slot, int value)
+    {
+        if (track_set(integers_, slot, value, integerBit)) {
+            integers_.queue(slot, value);
         }
-        if (!realsToFetch_.empty()) {
-            __realGetCache_.resize(realsToFetch_.size());
-            slave_->get_real(realsToFetch_, __realGetCache_);
+    }
 
-            realGetCache_.clear();
-            for (unsigned i = 0; i < realsToFetch_.size(); i++) {
-                const value_ref vr = realsToFetch_[i];
-                realGetCache_[vr] = __realGetCache_[i];
-            }
+    void set_real_at(size_t slot, double value)
+    {
+        if (track_set(reals_, slot, value, realBit)) {
+            reals_.queue(slot, value);
         }
-        if (!stringGetCache_.empty()) {
-            __stringGetCache_.resize(stringsToFetch_.size());
-            slave_->get_string(stringsToFetch_, __stringGetCache_);
+    }
 
-            stringGetCache_.clear();
-            for (unsigned i = 0; i < stringsToFetch_.size(); i++) {
-                const value_ref vr = stringsToFetch_[i];
-                stringGetCache_[vr] = __stringGetCache_[i];
-            }
+    void set_string_at(size_t slot, const std::string& value)
+    {
+        if (track_set(strings_, slot, value, stringBit)) {
+            strings_.queue(slot, value);
         }
-        if (!booleansToFetch_.empty()) {
-            __booleanGetCache_.resize(booleansToFetch_.size());
-            slave_->get_boolean(booleansToFetch_, __booleanGetCache_);
+    }
 
-            booleanGetCache_.clear();
-            for (unsigned i = 0; i < booleansToFetch_.size(); i++) {
-                const value_ref vr = booleansToFetch_[i];
-                booleanGetCache_[vr] = __booleanGetCache_[i];
-            }
+    void set_boolean_at(size_t slot, bool value)
+    {
+        if (track_set(booleans_, slot, value, booleanBit)) {
+            booleans_.queue(slot, value);
         }
-        if (!bytesToFetch_.empty()) {
-            __bytesGetCache_.resize(bytesToFetch_.size());
-            slave_->get_binary(bytesToFetch_, __bytesGetCache_);
+    }
 
-            bytesGetCache_.clear();
-            for (unsigned i = 0; i < bytesToFetch_.size(); i++) {
-                const value_ref vr = bytesToFetch_[i];
-                bytesGetCache_[vr] = __bytesGetCache_[i];
-            }
+    void set_int64_at(size_t slot, int64_t value)
+    {
+        if (track_set(int64s_, slot, value, int64Bit)) {
+            int64s_.queue(slot, value);
         }
     }
 
-    void mark_for_reading(const std::string& variableName)
+    void set_uint64_at(size_t slot, uint64_t value)
+    {
+        if (track_set(uint64s_, slot, value, uint64Bit)) {
+            uint64s_.queue(slot, value);
+        }
+    }
+
+    void set_float32_at(size_t slot, float value)
+    {
+        if (track_set(float32s_, slot, value, float32Bit)) {
+            float32s_.queue(slot, value);
+        }
+    }
+
+    // Redirects fetched values into externally owned buffers, e.g. a slice of a shared value store.
+    // The buffers must hold num_xxx() elements and outlive this slave (or the next call to attach_buffers).
+    void attach_buffers(int32_t* integers, double* reals, uint8_t* booleans, std::string* strings,
+        int64_t* int64s, uint64_t* uint64s, float* float32s)
+    {
+        std::copy_n(integerBuffer_, num_integers(), integers);
+        std::copy_n(realBuffer_, num_reals(), reals);
+        std::copy_n(booleanBuffer_, num_booleans(), booleans);
+        std::copy_n(stringBuffer_, num_strings(), strings);
+        std::copy_n(int64Buffer_, num_int64s(), int64s);
+        std::copy_n(uint64Buffer_, num_uint64s(), uint64s);
+        std::copy_n(float32Buffer_, num_float32s(), float32s);
+
+        integerBuffer_ = integers;
+        realBuffer_ = reals;
+        booleanBuffer_ = booleans;
+        stringBuffer_ = strings;
+        int64Buffer_ = int64s;
+        uint64Buffer_ = uint64s;
+        float32Buffer_ = float32s;
+    }
+
+    // Counters for the change detection applied to set values.
+    struct set_statistics
     {
+        size_t valuesQueued{0};  // values forwarded to the model
+        size_t valuesSkipped{0}; // values equal to the last value set, never forwarded
+        size_t callsIssued{0};   // batched set calls made on the model
+        size_t callsSkipped{0};  // batched set calls avoided as every value was unchanged
+    };
 
-        if (marked_variables.contains(variableName)) return;
+    [[nodiscard]] const set_statistics& get_set_statistics() const
+    {
+        return setStatistics_;
+    }
 
+    // Subscribes to a variable by name, see subscribe_xxx.
+    void mark_for_reading(const std::string& variableName)
+    {
         const auto& md = slave_->get_model_description();
 
-        const auto& v = md.get_by_name(variableName);
+        const auto* v = md.get_by_name(variableName);
         if (!v) throw std::runtime_error("No such variable '" + variableName + "'!");
 
-        const value_ref vr = v->vr;
-
         if (v->is_integer()) {
-            integersToFetch_.emplace_back(vr);
+            subscribe_integer(integer_slot(v->vr));
         } else if (v->is_real()) {
-            realsToFetch_.emplace_back(vr);
+            subscribe_real(real_slot(v->vr));
         } else if (v->is_string()) {
-            stringsToFetch_.emplace_back(vr);
+            subscribe_string(string_slot(v->vr));
         } else if (v->is_boolean()) {
-            booleansToFetch_.emplace_back(vr);
+            subscribe_boolean(boolean_slot(v->vr));
         } else if (v->is_binary()) {
-            bytesToFetch_.emplace_back(vr);
-        }
-
-        marked_variables.insert(variableName);
-
-        if (initialized) {
-            if (v->is_integer()) {
-                integerGetCache_[vr] = slave_->get_integer(vr);
-            } else if (v->is_real()) {
-                realGetCache_[vr] = slave_->get_real(vr);
-            } else if (v->is_string()) {
-                stringGetCache_[vr] = slave_->get_string(vr);
-            } else if (v->is_boolean()) {
-                booleanGetCache_[vr] = slave_->get_boolean(vr);
-            } else if (v->is_binary()) {
-                bytesGetCache_[vr] = slave_->get_binary(vr);
-            }
+            subscribe(binaries_, slot_of(binaries_, v->vr, "binary"), binaryValues_.data());
+        } else if (v->is_int64()) {
+            subscribe_int64(int64_slot(v->vr));
+        } else if (v->is_uint64()) {
+            subscribe_uint64(uint64_slot(v->vr));
+        } else if (v->is_float32()) {
+            subscribe_float32(float32_slot(v->vr));
         }
     }
 
@@ -330,33 +493,435 @@ public:
 private:
     std::unique_ptr<slave> slave_;
 
-    std::unordered_map<value_ref, int> integerSetCache_;
-    std::unordered_map<value_ref, double> realSetCache_;
-    std::unordered_map<value_ref, std::string> stringSetCache_;
-    std::unordered_map<value_ref, bool> boolSetCache_;
-    std::unordered_map<value_ref, std::vector<uint8_t>> bytesSetCache_;
+    static constexpr uint32_t noSlot = std::numeric_limits<uint32_t>::max();
+
+    static constexpr uint64_t finalGeneration = std::numeric_limits<uint64_t>::max();
+
+    enum class fetch_mode : uint8_t
+    {
+        none,  // never read
+        lazy,  // read now and then, fetched on demand
+        eager, // subscribed to, fetched on every call to receiveCachedGets
+    };
+
+    // Layout of values exchanged with the model through the span based batch calls of slave
+    template<class T>
+    using native_t = std::conditional_t<std::is_same_v<T, bool>, uint8_t,
+        std::conditional_t<std::is_same_v<T, std::string>, const char*, T>>;
+
+    // Variables of a single type fetched together in a single call
+    template<class T>
+    struct fetch_group
+    {
+        std::vector<value_ref> vrs;
+        std::vector<uint32_t> slots;
+        std::vector<native_t<T>> values;
+        uint64_t fetchedAt{0};
+
+        void add(value_ref vr, uint32_t slot)
+        {
+            vrs.emplace_back(vr);
+            slots.emplace_back(slot);
+            values.resize(vrs.size());
+        }
+
+        // Removes the variables of slots matching a predicate, keeping the order of the others.
+        template<class P>
+        void remove_if(P&& predicate)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < slots.size(); ++i) {
+                if (!predicate(slots[i])) {
+                    vrs[kept] = vrs[i];
+                    slots[kept] = slots[i];
+                    ++kept;
+                }
+            }
+            vrs.resize(kept);
+            slots.resize(kept);
+            values.resize(kept);
+        }
+    };
+
+    // Bookkeeping of the variables of a single type, indexed by slot.
+    // Batches are sized once and reused, such that fetching and setting values does not allocate.
+    template<class T>
+    struct typed_variables
+    {
+        std::vector<value_ref> vrs;       // slot -> vr
+        std::vector<uint8_t> isStatic;    // constants and fixed parameters, which need only be fetched once initialized
+
+        // vr -> slot, as a dense array when value references are compact, otherwise hashed
+        std::vector<uint32_t> denseSlots;
+        std::unordered_map<value_ref, uint32_t> sparseSlots;
+
+        std::vector<fetch_mode> mode;
+        std::vector<uint64_t> fetchedAt; // generation of the last fetch, or finalGeneration
+        fetch_group<T> eager;
+        fetch_group<T> lazy;
+        fetch_group<T> single; // a lone variable fetched on its own
+
+        using stored_type = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+        // variables queued to be set, at most once per slot
+        std::vector<int32_t> setPosition; // slot -> index within the batch, -1 when not queued
+        std::vector<value_ref> setVrs;
+        std::vector<uint32_t> setSlots;
+        std::vector<stored_type> setValues;
+        std::vector<const char*> setStrings; // views of queued strings, handed to the model
+
+        // last value set per slot, only meaningful when flagged as known
+        std::vector<stored_type> lastValues;
+        std::vector<uint8_t> lastKnown;
+
+        void add(const scalar_variable& v)
+        {
+            vrs.emplace_back(v.vr);
+            const auto& variability = v.variability;
+            isStatic.emplace_back(variability == "Constant" || variability == "Fixed" || variability == "Parameter");
+        }
+
+        void build()
+        {
+            const size_t numSlots = vrs.size();
+            const value_ref maxVr = numSlots == 0 ? 0 : *std::ranges::max_element(vrs);
+            if (maxVr < std::max<size_t>(64, 4 * numSlots)) {
+                denseSlots.assign(static_cast<size_t>(maxVr) + 1, noSlot);
+                for (uint32_t slot = 0; slot < numSlots; ++slot) {
+                    denseSlots[vrs[slot]] = slot;
+                }
+            } else {
+                for (uint32_t slot = 0; slot < numSlots; ++slot) {
+                    sparseSlots.emplace(vrs[slot], slot);
+                }
+            }
+
+            mode.assign(numSlots, fetch_mode::none);
+            fetchedAt.assign(numSlots, 0);
+            eager.vrs.reserve(numSlots);
+            lazy.vrs.reserve(numSlots);
+            single.add(0, 0);
+
+            setPosition.assign(numSlots, -1);
+            setVrs.reserve(numSlots);
+            setSlots.reserve(numSlots);
+            setValues.reserve(numSlots);
+            if constexpr (std::is_same_v<T, std::string>) {
+                setStrings.reserve(numSlots);
+            }
+
+            lastValues.resize(numSlots);
+            lastKnown.assign(numSlots, 0);
+        }
 
-    std::unordered_map<value_ref, int> integerGetCache_;
-    std::unordered_map<value_ref, double> realGetCache_;
-    std::unordered_map<value_ref, std::string> stringGetCache_;
-    std::unordered_map<value_ref, bool> booleanGetCache_;
-    std::unordered_map<value_ref, std::vector<uint8_t>> bytesGetCache_;
+        // Outdates all values, and fetches static values again, e.g. after a reset.
+        void restart()
+        {
+            std::ranges::fill(fetchedAt, 0);
+            eager = {};
+            lazy = {};
+            for (uint32_t slot = 0; slot < vrs.size(); ++slot) {
+                regroup(slot);
+            }
+        }
 
-    std::vector<int> __integerGetCache_;
-    std::vector<double> __realGetCache_;
-    std::vector<std::string> __stringGetCache_;
-    std::vector<bool> __booleanGetCache_;
-    std::vector<std::vector<uint8_t>> __bytesGetCache_;
+        // Adds a slot back to the group of its fetch mode.
+        void regroup(uint32_t slot)
+        {
+            if (mode[slot] == fetch_mode::eager) {
+                eager.add(vrs[slot], slot);
+            } else if (mode[slot] == fetch_mode::lazy) {
+                lazy.add(vrs[slot], slot);
+            }
+        }
 
-    std::vector<value_ref> integersToFetch_;
-    std::vector<value_ref> realsToFetch_;
-    std::vector<value_ref> stringsToFetch_;
-    std::vector<value_ref> booleansToFetch_;
-    std::vector<value_ref> bytesToFetch_;
+        [[nodiscard]] uint32_t find(value_ref vr) const
+        {
+            if (!sparseSlots.empty()) {
+                const auto it = sparseSlots.find(vr);
+                return it == sparseSlots.end() ? noSlot : it->second;
+            }
+            return vr < denseSlots.size() ? denseSlots[vr] : noSlot;
+        }
 
-    std::set<std::string> marked_variables;
+        void queue(size_t slot, const T& value)
+        {
+            auto& position = setPosition[slot];
+            if (position < 0) {
+                position = static_cast<int32_t>(setVrs.size());
+                setVrs.emplace_back(vrs[slot]);
+                setSlots.emplace_back(static_cast<uint32_t>(slot));
+                setValues.emplace_back(value);
+            } else {
+                setValues[position] = value;
+            }
+        }
+    };
+
+    typed_variables<int> integers_;
+    typed_variables<double> reals_;
+    typed_variables<std::string> strings_;
+    typed_variables<bool> booleans_;
+    typed_variables<std::vector<uint8_t>> binaries_;
+    typed_variables<int64_t> int64s_;
+    typed_variables<uint64_t> uint64s_;
+    typed_variables<float> float32s_;
+
+    static constexpr uint8_t integerBit = 1;
+    static constexpr uint8_t realBit = 2;
+    static constexpr uint8_t stringBit = 4;
+    static constexpr uint8_t booleanBit = 8;
+    static constexpr uint8_t int64Bit = 16;
+    static constexpr uint8_t uint64Bit = 32;
+    static constexpr uint8_t float32Bit = 64;
+    uint8_t skippedTypes_{0};
+
+    set_statistics setStatistics_;
+
+    // owned value buffers, used until attach_buffers() is called
+    std::vector<int32_t> integerValues_;
+    std::vector<double> realValues_;
+    std::vector<std::string> stringValues_;
+    std::vector<uint8_t> booleanValues_;
+    std::vector<std::vector<uint8_t>> binaryValues_;
+    std::vector<int64_t> int64Values_;
+    std::vector<uint64_t> uint64Values_;
+    std::vector<float> float32Values_;
+
+    int32_t* integerBuffer_;
+    double* realBuffer_;
+    std::string* stringBuffer_;
+    uint8_t* booleanBuffer_;
+    int64_t* int64Buffer_;
+    uint64_t* uint64Buffer_;
+    float* float32Buffer_;
 
     bool initialized{false};
+    bool finalizeStatics_{false};
+    uint64_t generation_{1};
+
+    template<class T>
+    static size_t slot_of(const typed_variables<T>& variables, value_ref vr, const char* type)
+    {
+        const uint32_t slot = variables.find(vr);
+        if (slot == noSlot) {
+            throw std::runtime_error("No " + std::string(type) + " variable with valueReference=" + std::to_string(vr) + "!");
+        }
+        return slot;
+    }
+
+    // Slot of a variable being read, which is brought up to date if outdated.
+    template<class T>
+    size_t fresh_slot(typed_variables<T>& variables, value_ref vr, const char* type)
+    {
+        const size_t slot = slot_of(variables, vr, type);
+        if (variables.fetchedAt[slot] < generation_) {
+            refresh(variables, slot, buffer_of<T>());
+        }
+        return slot;
+    }
+
+    template<class T>
+    auto buffer_of()
+    {
+        if constexpr (std::is_same_v<T, int>) {
+            return integerBuffer_;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return realBuffer_;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return stringBuffer_;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return booleanBuffer_;
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            return int64Buffer_;
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            return uint64Buffer_;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return float32Buffer_;
+        } else {
+            return binaryValues_.data();
+        }
+    }
+
+    template<class T>
+    void get_values(const std::vector<value_ref>& vrs, std::vector<native_t<T>>& values)
+    {
+        if constexpr (std::is_same_v<T, int>) {
+            slave_->get_integer(std::span(vrs), std::span(values));
+        } else if constexpr (std::is_same_v<T, double>) {
+            slave_->get_real(std::span(vrs), std::span(values));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            slave_->get_string(std::span(vrs), std::span(values));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            slave_->get_boolean(std::span(vrs), std::span(values));
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            slave_->get_int64(std::span(vrs), std::span(values));
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            slave_->get_uint64(std::span(vrs), std::span(values));
+        } else if constexpr (std::is_same_v<T, float>) {
+            slave_->get_float32(std::span(vrs), std::span(values));
+        } else {
+            slave_->get_binary(vrs, values);
+        }
+    }
+
+    template<class T>
+    void set_values(typed_variables<T>& variables)
+    {
+        const std::span<const value_ref> vrs(variables.setVrs);
+        if constexpr (std::is_same_v<T, int>) {
+            slave_->set_integer(vrs, std::span<const int32_t>(variables.setValues));
+        } else if constexpr (std::is_same_v<T, double>) {
+            slave_->set_real(vrs, std::span<const double>(variables.setValues));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            variables.setStrings.clear();
+            for (const auto& value : variables.setValues) {
+                variables.setStrings.emplace_back(value.c_str());
+            }
+            slave_->set_string(vrs, std::span<const char* const>(variables.setStrings));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            slave_->set_boolean(vrs, std::span<const uint8_t>(variables.setValues));
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            slave_->set_int64(vrs, std::span<const int64_t>(variables.setValues));
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            slave_->set_uint64(vrs, std::span<const uint64_t>(variables.setValues));
+        } else if constexpr (std::is_same_v<T, float>) {
+            slave_->set_float32(vrs, std::span<const float>(variables.setValues));
+        } else {
+            slave_->set_binary(variables.setVrs, variables.setValues);
+        }
+    }
+
+    // Fetches the values of a group, static values fetched once initialized are final and leave the group.
+    template<class T, class V>
+    void fetch(typed_variables<T>& variables, fetch_group<T>& group, V* values)
+    {
+        group.fetchedAt = generation_;
+        if (group.vrs.empty()) return;
+
+        get_values<T>(group.vrs, group.values);
+        bool anyFinal = false;
+        for (size_t i = 0; i < group.slots.size(); i++) {
+            const auto slot = group.slots[i];
+            if constexpr (std::is_same_v<T, std::string>) {
+                const char* value = group.values[i];
+                values[slot] = value ? value : "";
+            } else {
+                values[slot] = group.values[i];
+            }
+            if (finalizeStatics_ && variables.isStatic[slot]) {
+                variables.fetchedAt[slot] = finalGeneration;
+                anyFinal = true;
+            } else {
+                variables.fetchedAt[slot] = generation_;
+            }
+        }
+        if (anyFinal) {
+            group.remove_if([&](uint32_t slot) { return variables.fetchedAt[slot] == finalGeneration; });
+        }
+    }
+
+    template<class T, class V>
+    void fetch_single(typed_variables<T>& variables, size_t slot, V* values)
+    {
+        variables.single.vrs[0] = variables.vrs[slot];
+        variables.single.slots[0] = static_cast<uint32_t>(slot);
+        fetch(variables, variables.single, values);
+        variables.single.vrs.resize(1);
+        variables.single.slots.resize(1);
+        variables.single.values.resize(1);
+    }
+
+    template<class T, class V>
+    void subscribe(typed_variables<T>& variables, size_t slot, V* values)
+    {
+        auto& mode = variables.mode[slot];
+        if (mode == fetch_mode::eager) return;
+
+        if (mode == fetch_mode::lazy) {
+            variables.lazy.remove_if([&](uint32_t s) { return s == slot; });
+        }
+        mode = fetch_mode::eager;
+        if (variables.fetchedAt[slot] == finalGeneration) return;
+
+        variables.eager.add(variables.vrs[slot], static_cast<uint32_t>(slot));
+        if (initialized && variables.fetchedAt[slot] < generation_) {
+            fetch_single(variables, slot, values);
+        }
+    }
+
+    template<class T, class V>
+    void refresh(typed_variables<T>& variables, size_t slot, V* values)
+    {
+        auto& mode = variables.mode[slot];
+        if (mode == fetch_mode::none) {
+            mode = fetch_mode::lazy;
+            if (variables.lazy.fetchedAt == generation_) {
+                // the others are up to date already
+                if (initialized) fetch_single(variables, slot, values);
+                if (variables.fetchedAt[slot] != finalGeneration) variables.lazy.add(variables.vrs[slot], static_cast<uint32_t>(slot));
+                return;
+            }
+            variables.lazy.add(variables.vrs[slot], static_cast<uint32_t>(slot));
+        }
+        if (!initialized) return;
+
+        if (mode == fetch_mode::lazy) {
+            fetch(variables, variables.lazy, values);
+        } else {
+            // subscribed after the last call to receiveCachedGets
+            fetch_single(variables, slot, values);
+        }
+    }
+
+    template<class T>
+    void transfer(typed_variables<T>& variables, uint8_t typeBit)
+    {
+        if (!variables.setVrs.empty()) {
+            set_values(variables);
+            for (const auto slot : variables.setSlots) {
+                variables.setPosition[slot] = -1;
+                if (variables.fetchedAt[slot] == finalGeneration) [[unlikely]] {
+                    // a static value set anyway, e.g. while initializing again
+                    variables.fetchedAt[slot] = 0;
+                    variables.regroup(slot);
+                }
+            }
+            variables.setVrs.clear();
+            variables.setSlots.clear();
+            variables.setValues.clear();
+            ++setStatistics_.callsIssued;
+        } else if (skippedTypes_ & typeBit) {
+            ++setStatistics_.callsSkipped;
+        }
+    }
+
+    // Records a value about to be set. Returns false if it equals the last value set, in which case it can be skipped.
+    template<class T, class V>
+    bool track_set(typed_variables<T>& variables, size_t slot, const V& value, uint8_t typeBit)
+    {
+        if (variables.lastKnown[slot] && variables.lastValues[slot] == value) {
+            ++setStatistics_.valuesSkipped;
+            skippedTypes_ |= typeBit;
+            return false;
+        }
+        variables.lastValues[slot] = value;
+        variables.lastKnown[slot] = true;
+        ++setStatistics_.valuesQueued;
+        return true;
+    }
+
+    // Forgets the last values set, e.g. after the model has been reset or its state restored.
+    void invalidate_sets()
+    {
+        std::ranges::fill(integers_.lastKnown, 0);
+        std::ranges::fill(reals_.lastKnown, 0);
+        std::ranges::fill(strings_.lastKnown, 0);
+        std::ranges::fill(booleans_.lastKnown, 0);
+        std::ranges::fill(int64s_.lastKnown, 0);
+        std::ranges::fill(uint64s_.lastKnown, 0);
+        std::ranges::fill(float32s_.lastKnown, 0);
+    }
 };
 
 } // namespace fmilibcpp
@@ -121,65 +121,105 @@ bool fmi1_slave::reset()
 
 bool fmi1_slave::get_integer(const std::vector<value_ref>& vr, std::vector<int32_t>& values)
 {
-    const auto status = fmi1_getInteger(component_, vr.data(), vr.size(), values.data());
-    return status == fmi1OK;
+    return get_integer(std::span(vr), std::span(values));
 }
 
 bool fmi1_slave::get_real(const std::vector<value_ref>& vr, std::vector<double>& values)
 {
-    const auto status = fmi1_getReal(component_, vr.data(), vr.size(), values.data());
-    return status == fmi1OK;
+    return get_real(std::span(vr), std::span(values));
 }
 
 bool fmi1_slave::get_string(const std::vector<value_ref>& vr, std::vector<std::string>& values)
 {
-    auto tmp = std::vector<fmi1String>(vr.size());
-    const auto status = fmi1_getString(component_, vr.data(), vr.size(), tmp.data());
+    auto tmp = std::vector<const char*>(vr.size());
+    const auto status = get_string(std::span(vr), std::span(tmp));
     for (auto i = 0; i < tmp.size(); i++) {
         values[i] = tmp[i];
     }
-    return status == fmi1OK;
+    return status;
 }
 
 bool fmi1_slave::get_boolean(const std::vector<value_ref>& vr, std::vector<bool>& values)
 {
-    auto tmp = std::vector<fmi1Boolean>(vr.size());
-    const auto status = fmi1_getBoolean(component_, vr.data(), vr.size(), tmp.data());
+    auto tmp = std::vector<uint8_t>(vr.size());
+    const auto status = get_boolean(std::span(vr), std::span(tmp));
     for (auto i = 0; i < tmp.size(); i++) {
         values[i] = tmp[i] != 0;
     }
-    return status == fmi1OK;
+    return status;
 }
 
 bool fmi1_slave::set_integer(const std::vector<value_ref>& vr, const std::vector<int32_t>& values)
 {
-    const auto status = fmi1_setInteger(component_, vr.data(), vr.size(), values.data());
-    return status == fmi1OK;
+    return set_integer(std::span(vr), std::span(values));
 }
 
 bool fmi1_slave::set_real(const std::vector<value_ref>& vr, const std::vector<double>& values)
 {
-    const auto status = fmi1_setReal(component_, vr.data(), vr.size(), values.data());
-    return status == fmi1OK;
+    return set_real(std::span(vr), std::span(values));
 }
 
 bool fmi1_slave::set_string(const std::vector<value_ref>& vr, const std::vector<std::string>& values)
 {
-    std::vector<fmi1String> _values(vr.size());
+    std::vector<const char*> _values(vr.size());
     for (auto i = 0; i < vr.size(); i++) {
         _values[i] = values[i].c_str();
     }
-    const auto status = fmi1_setString(component_, vr.data(), vr.size(), _values.data());
-    return status == fmi1OK;
+    return set_string(std::span(vr), std::span<const char* const>(_values));
 }
 
 bool fmi1_slave::set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values)
 {
-    std::vector<fmi1Boolean> _values(vr.size());
-    for (auto i = 0; i < vr.size(); i++) {
-        _values[i] = values[i] ? fmi1True : fmi1False;
-    }
-    const auto status = fmi1_setBoolean(component_, vr.data(), vr.size(), _values.data());
+    std::vector<uint8_t> _values(values.begin(), values.end());
+    return set_boolean(std::span(vr), std::span<const uint8_t>(_values));
+}
+
+bool fmi1_slave::get_integer(std::span<const value_ref> vr, std::span<int32_t> values)
+{
+    const auto status = fmi1_getInteger(component_, vr.data(), vr.size(), values.data());
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::get_real(std::span<const value_ref> vr, std::span<double> values)
+{
+    const auto status = fmi1_getReal(component_, vr.data(), vr.size(), values.data());
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::get_string(std::span<const value_ref> vr, std::span<const char*> values)
+{
+    const auto status = fmi1_getString(component_, vr.data(), vr.size(), values.data());
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::get_boolean(std::span<const value_ref> vr, std::span<uint8_t> values)
+{
+    // fmi1Boolean is a char, and shares the layout of the byte buffer
+    const auto status = fmi1_getBoolean(component_, vr.data(), vr.size(), reinterpret_cast<fmi1Boolean*>(values.data()));
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::set_integer(std::span<const value_ref> vr, std::span<const int32_t> values)
+{
+    const auto status = fmi1_setInteger(component_, vr.data(), vr.size(), values.data());
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::set_real(std::span<const value_ref> vr, std::span<const double> values)
+{
+    const auto status = fmi1_setReal(component_, vr.data(), vr.size(), values.data());
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::set_string(std::span<const value_ref> vr, std::span<const char* const> values)
+{
+    const auto status = fmi1_setString(component_, vr.data(), vr.size(), values.data());
+    return status == fmi1OK;
+}
+
+bool fmi1_slave::set_boolean(std::span<const value_ref> vr, std::span<const uint8_t> values)
+{
+    const auto status = fmi1_setBoolean(component_, vr.data(), vr.size(), reinterpret_cast<const fmi1Boolean*>(values.data()));
     return status == fmi1OK;
 }
 
@@ -9,6 +9,7 @@
 #include <fmi4c.h>
 
 #include <memory>
+#include <span>
 
 namespace fmilibcpp
 {
@@ -44,6 +45,16 @@ public:
     bool set_string(const std::vector<value_ref>& vr, const std::vector<std::string>& values) override;
     bool set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values) override;
 
+    bool get_integer(std::span<const value_ref> vr, std::span<int32_t> values) override;
+    bool get_real(std::span<const value_ref> vr, std::span<double> values) override;
+    bool get_string(std::span<const value_ref> vr, std::span<const char*> values) override;
+    bool get_boolean(std::span<const value_ref> vr, std::span<uint8_t> values) override;
+
+    bool set_integer(std::span<const value_ref> vr, std::span<const int32_t> values) override;
+    bool set_real(std::span<const value_ref> vr, std::span<const double> values) override;
+    bool set_string(std::span<const value_ref> vr, std::span<const char* const> values) override;
+    bool set_boolean(std::span<const value_ref> vr, std::span<const uint8_t> values) override;
+
     ~fmi1_slave() override;
 
 private:
@@ -105,7 +105,7 @@ model_description create_fmi2_model_description(fmuHandle* handle)
     for (auto i = 0; i < varCount; i++) {
         const auto var = fmi2_getVariableByIndex(handle, i+1);
         if (const auto scalar = to_scalar_variable(var)) {
-            md.modelVariables.push_back(scalar.value());
+            md.add_variable(scalar.value());
         }
     }
 
@@ -3,6 +3,7 @@
 
 #include <fmi4c.h>
 
+#include <algorithm>
 #include <cstdarg>
 #include <iostream>
 #include <memory>
@@ -120,65 +121,112 @@ bool fmi2_slave::reset()
 
 bool fmi2_slave::get_integer(const std::vector<value_ref>& vr, std::vector<int32_t>& values)
 {
-    const auto status = fmi2_getInteger(component, vr.data(), vr.size(), values.data());
-    return status == fmi2OK;
+    return get_integer(std::span(vr), std::span(values));
 }
 
 bool fmi2_slave::get_real(const std::vector<value_ref>& vr, std::vector<double>& values)
 {
-    const auto status = fmi2_getReal(component, vr.data(), vr.size(), values.data());
-    return status == fmi2OK;
+    return get_real(std::span(vr), std::span(values));
 }
 
 bool fmi2_slave::get_string(const std::vector<value_ref>& vr, std::vector<std::string>& values)
 {
-    auto tmp = std::vector<fmi2String>(vr.size());
-    const auto status = fmi2_getString(component, vr.data(), vr.size(), tmp.data());
+    auto tmp = std::vector<const char*>(vr.size());
+    const auto status = get_string(std::span(vr), std::span(tmp));
     for (auto i = 0; i < tmp.size(); i++) {
         values[i] = tmp[i];
     }
-    return status == fmi2OK;
+    return status;
 }
 
 bool fmi2_slave::get_boolean(const std::vector<value_ref>& vr, std::vector<bool>& values)
 {
-    auto tmp = std::vector<fmi2Boolean>(vr.size());
-    const auto status = fmi2_getBoolean(component, vr.data(), vr.size(), tmp.data());
+    auto tmp = std::vector<uint8_t>(vr.size());
+    const auto status = get_boolean(std::span(vr), std::span(tmp));
     for (auto i = 0; i < tmp.size(); i++) {
         values[i] = tmp[i] != 0;
     }
-    return status == fmi2OK;
+    return status;
 }
 
 bool fmi2_slave::set_integer(const std::vector<value_ref>& vr, const std::vector<int>& values)
 {
-    const auto status = fmi2_setInteger(component, vr.data(), vr.size(), values.data());
-    return status == fmi2OK;
+    return set_integer(std::span(vr), std::span(values));
 }
 
 bool fmi2_slave::set_real(const std::vector<value_ref>& vr, const std::vector<double>& values)
 {
-    const auto status = fmi2_setReal(component, vr.data(), vr.size(), values.data());
-    return status == fmi2OK;
+    return set_real(std::span(vr), std::span(values));
 }
 
 bool fmi2_slave::set_string(const std::vector<value_ref>& vr, const std::vector<std::string>& values)
 {
-    std::vector<fmi2String> _values(vr.size());
+    std::vector<const char*> _values(vr.size());
     for (auto i = 0; i < vr.size(); i++) {
         _values[i] = values[i].c_str();
     }
-    const auto status = fmi2_setString(component, vr.data(), vr.size(), _values.data());
-    return status == fmi2OK;
+    return set_string(std::span(vr), std::span<const char* const>(_values));
 }
 
 bool fmi2_slave::set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values)
 {
-    std::vector<fmi2Boolean> _values(vr.size());
+    std::vector<uint8_t> _values(values.begin(), values.end());
+    return set_boolean(std::span(vr), std::span<const uint8_t>(_values));
+}
+
+bool fmi2_slave::get_integer(std::span<const value_ref> vr, std::span<int32_t> values)
+{
+    const auto status = fmi2_getInteger(component, vr.data(), vr.size(), values.data());
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::get_real(std::span<const value_ref> vr, std::span<double> values)
+{
+    const auto status = fmi2_getReal(component, vr.data(), vr.size(), values.data());
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::get_string(std::span<const value_ref> vr, std::span<const char*> values)
+{
+    const auto status = fmi2_getString(component, vr.data(), vr.size(), values.data());
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::get_boolean(std::span<const value_ref> vr, std::span<uint8_t> values)
+{
+    booleans_.resize(std::max(booleans_.size(), vr.size()));
+    const auto status = fmi2_getBoolean(component, vr.data(), vr.size(), booleans_.data());
+    for (auto i = 0; i < vr.size(); i++) {
+        values[i] = booleans_[i] != fmi2False;
+    }
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::set_integer(std::span<const value_ref> vr, std::span<const int32_t> values)
+{
+    const auto status = fmi2_setInteger(component, vr.data(), vr.size(), values.data());
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::set_real(std::span<const value_ref> vr, std::span<const double> values)
+{
+    const auto status = fmi2_setReal(component, vr.data(), vr.size(), values.data());
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::set_string(std::span<const value_ref> vr, std::span<const char* const> values)
+{
+    const auto status = fmi2_setString(component, vr.data(), vr.size(), values.data());
+    return status == fmi2OK;
+}
+
+bool fmi2_slave::set_boolean(std::span<const value_ref> vr, std::span<const uint8_t> values)
+{
+    booleans_.resize(std::max(booleans_.size(), vr.size()));
     for (auto i = 0; i < vr.size(); i++) {
-        _values[i] = values[i] ? fmi2True : fmi2False;
+        booleans_[i] = values[i] ? fmi2True : fmi2False;
     }
-    const auto status = fmi2_setBoolean(component, vr.data(), vr.size(), _values.data());
+    const auto status = fmi2_setBoolean(component, vr.data(), vr.size(), booleans_.data());
     return status == fmi2OK;
 }
 
@@ -9,6 +9,8 @@
 
 #include <fmi4c.h>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace fmilibcpp
 {
@@ -48,6 +50,16 @@ public:
     bool set_string(const std::vector<value_ref>& vr, const std::vector<std::string>& values) override;
     bool set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values) override;
 
+    bool get_integer(std::span<const value_ref> vr, std::span<int32_t> values) override;
+    bool get_real(std::span<const value_ref> vr, std::span<double> values) override;
+    bool get_string(std::span<const value_ref> vr, std::span<const char*> values) override;
+    bool get_boolean(std::span<const value_ref> vr, std::span<uint8_t> values) override;
+
+    bool set_integer(std::span<const value_ref> vr, std::span<const int32_t> values) override;
+    bool set_real(std::span<const value_ref> vr, std::span<const double> values) override;
+    bool set_string(std::span<const value_ref> vr, std::span<const char* const> values) override;
+    bool set_boolean(std::span<const value_ref> vr, std::span<const uint8_t> values) override;
+
     ~fmi2_slave() override;
 
 private:
@@ -56,6 +68,8 @@ private:
     std::shared_ptr<fmicontext> ctx_;
 
     model_description md_;
+
+    std::vector<fmi2Boolean> booleans_; // fmi2Boolean is an int, converted to and from bytes
 };
 
 } // namespace fmilibcpp
@@ -0,0 +1,226 @@
+#ifndef ECOS_FMI_FMI3_BATCHES_HPP
+#define ECOS_FMI_FMI3_BATCHES_HPP
+
+#include "fmilibcpp/slave.hpp"
+
+#include "ecos/logger/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fmilibcpp
+{
+
+// Data types of FMI 3 variables accessed through a wider type, each with its own native call.
+enum class fmi3_type : uint8_t
+{
+    int8,
+    int16,
+    int32,
+    uint8,
+    uint16,
+    uint32,
+    int64,
+    float64
+};
+
+/**
+ * \brief Splits batches of FMI 3 variables by data type.
+ *
+ * Int8, Int16, Int32, UInt8 and UInt16 variables are accessed as int32_t, Int64 and UInt32 variables as int64_t,
+ * and Float64 variables as double. A batch is issued as one native call per data type, through scratch buffers
+ * of that type. The grouping of a batch is kept and reused as long as the same value references are passed again,
+ * as buffered_slave does every step.
+ *
+ * Calls is any type providing, for each native type T, bool get(const value_ref*, size_t, T*) and
+ * bool set(const value_ref*, size_t, const T*), e.g. forwarding to fmi4c.
+ */
+class fmi3_batches
+{
+
+public:
+    fmi3_batches(std::string instanceName, std::unordered_map<value_ref, fmi3_type> types)
+        : instanceName_(std::move(instanceName))
+        , types_(std::move(types))
+    { }
+
+    template<class V, class Calls>
+    bool get(Calls& calls, std::span<const value_ref> vr, std::span<V> values)
+    {
+        const auto groups = group<V>(vr);
+        if (!groups) return false;
+
+        bool ok = true;
+        for (const auto& g : *groups) {
+            switch (g.type) {
+                case fmi3_type::int8: ok &= get_group<int8_t>(calls, g, vr, values); break;
+                case fmi3_type::int16: ok &= get_group<int16_t>(calls, g, vr, values); break;
+                case fmi3_type::int32: ok &= get_group<int32_t>(calls, g, vr, values); break;
+                case fmi3_type::uint8: ok &= get_group<uint8_t>(calls, g, vr, values); break;
+                case fmi3_type::uint16: ok &= get_group<uint16_t>(calls, g, vr, values); break;
+                case fmi3_type::uint32: ok &= get_group<uint32_t>(calls, g, vr, values); break;
+                case fmi3_type::int64: ok &= get_group<int64_t>(calls, g, vr, values); break;
+                case fmi3_type::float64: ok &= get_group<double>(calls, g, vr, values); break;
+            }
+        }
+        return ok;
+    }
+
+    template<class V, class Calls>
+    bool set(Calls& calls, std::span<const value_ref> vr, std::span<const V> values)
+    {
+        const auto groups = group<V>(vr);
+        if (!groups) return false;
+
+        bool ok = true;
+        for (const auto& g : *groups) {
+            switch (g.type) {
+                case fmi3_type::int8: ok &= set_group<int8_t>(calls, g, vr, values); break;
+                case fmi3_type::int16: ok &= set_group<int16_t>(calls, g, vr, values); break;
+                case fmi3_type::int32: ok &= set_group<int32_t>(calls, g, vr, values); break;
+                case fmi3_type::uint8: ok &= set_group<uint8_t>(calls, g, vr, values); break;
+                case fmi3_type::uint16: ok &= set_group<uint16_t>(calls, g, vr, values); break;
+                case fmi3_type::uint32: ok &= set_group<uint32_t>(calls, g, vr, values); break;
+                case fmi3_type::int64: ok &= set_group<int64_t>(calls, g, vr, values); break;
+                case fmi3_type::float64: ok &= set_group<double>(calls, g, vr, values); break;
+            }
+        }
+        return ok;
+    }
+
+    // Number of batches whose grouping is kept.
+    [[nodiscard]] size_t num_cached() const
+    {
+        return cache_.size();
+    }
+
+private:
+    // batches beyond this many are grouped anew, replacing the oldest grouping kept
+    static constexpr size_t maxCached = 16;
+
+    // Variables of a single data type within a batch, and their position within the batch
+    struct typed_group
+    {
+        fmi3_type type;
+        std::vector<value_ref> vrs;
+        std::vector<uint32_t> positions;
+    };
+
+    struct grouping
+    {
+        int family;
+        std::vector<value_ref> vrs;
+        std::vector<typed_group> groups;
+    };
+
+    std::string instanceName_;
+    std::unordered_map<value_ref, fmi3_type> types_;
+    std::vector<grouping> cache_;
+    size_t next_{0};
+    std::tuple<std::vector<int8_t>, std::vector<int16_t>, std::vector<int32_t>, std::vector<uint8_t>,
+        std::vector<uint16_t>, std::vector<uint32_t>, std::vector<int64_t>, std::vector<double>>
+        scratch_;
+
+    // The wider type a variable is accessed through: 0 for int32_t, 1 for int64_t and 2 for double
+    static int family_of(fmi3_type type)
+    {
+        switch (type) {
+            case fmi3_type::uint32:
+            case fmi3_type::int64: return 1;
+            case fmi3_type::float64: return 2;
+            default: return 0;
+        }
+    }
+
+    template<class V>
+    static constexpr int family_of()
+    {
+        static_assert(std::is_same_v<V, int32_t> || std::is_same_v<V, int64_t> || std::is_same_v<V, double>);
+        return std::is_same_v<V, int32_t> ? 0 : std::is_same_v<V, int64_t> ? 1 : 2;
+    }
+
+    template<class V>
+    const std::vector<typed_group>* group(std::span<const value_ref> vr)
+    {
+        constexpr int family = family_of<V>();
+        for (const auto& g : cache_) {
+            if (g.family == family && std::ranges::equal(g.vrs, vr)) {
+                return &g.groups;
+            }
+        }
+
+        grouping g{family, std::vector(vr.begin(), vr.end()), {}};
+        std::array<int, 8> index{};
+        index.fill(-1);
+        for (uint32_t i = 0; i < vr.size(); ++i) {
+            const auto it = types_.find(vr[i]);
+            if (it == types_.end() || family_of(it->second) != family) {
+                ecos::log::err("[{}] No {} variable with valueReference={}", instanceName_,
+                    family == 0 ? "integer" : family == 1 ? "64-bit integer" : "real", vr[i]);
+                return nullptr;
+            }
+            auto& slot = index[static_cast<size_t>(it->second)];
+            if (slot < 0) {
+                slot = static_cast<int>(g.groups.size());
+                g.groups.push_back({it->second, {}, {}});
+            }
+            g.groups[slot].vrs.emplace_back(vr[i]);
+            g.groups[slot].positions.emplace_back(i);
+        }
+
+        if (cache_.size() < maxCached) {
+            return &cache_.emplace_back(std::move(g)).groups;
+        }
+        auto& replaced = cache_[next_++ % maxCached];
+        replaced = std::move(g);
+        return &replaced.groups;
+    }
+
+    template<class T, class V, class Calls>
+    bool get_group(Calls& calls, const typed_group& g, std::span<const value_ref> vr, std::span<V> values)
+    {
+        if constexpr (std::is_same_v<T, V>) {
+            if (g.vrs.size() == vr.size()) {
+                // a batch of a single data type, read in place
+                return calls.get(vr.data(), vr.size(), values.data());
+            }
+        }
+
+        auto& scratch = std::get<std::vector<T>>(scratch_);
+        scratch.resize(g.vrs.size());
+        const bool ok = calls.get(g.vrs.data(), g.vrs.size(), scratch.data());
+        for (size_t i = 0; i < g.positions.size(); ++i) {
+            values[g.positions[i]] = static_cast<V>(scratch[i]);
+        }
+        return ok;
+    }
+
+    template<class T, class V, class Calls>
+    bool set_group(Calls& calls, const typed_group& g, std::span<const value_ref> vr, std::span<const V> values)
+    {
+        if constexpr (std::is_same_v<T, V>) {
+            if (g.vrs.size() == vr.size()) {
+                return calls.set(vr.data(), vr.size(), values.data());
+            }
+        }
+
+        auto& scratch = std::get<std::vector<T>>(scratch_);
+        scratch.resize(g.vrs.size());
+        for (size_t i = 0; i < g.positions.size(); ++i) {
+            scratch[i] = static_cast<T>(values[g.positions[i]]);
+        }
+        return calls.set(g.vrs.data(), g.vrs.size(), scratch.data());
+    }
+};
+
+} // namespace fmilibcpp
+
+#endif // ECOS_FMI_FMI3_BATCHES_HPP
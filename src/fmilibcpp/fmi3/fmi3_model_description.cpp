@@ -15,16 +15,10 @@ int32_t getStartInt(fmi3VariableHandle* v, fmi3DataType type)
             return fmi3_getVariableStartInt16(v);
         case fmi3DataTypeInt32:
             return fmi3_getVariableStartInt32(v);
-        case fmi3DataTypeInt64:
-            return fmi3_getVariableStartInt64(v);
         case fmi3DataTypeUInt8:
             return fmi3_getVariableStartUInt8(v);
         case fmi3DataTypeUInt16:
             return fmi3_getVariableStartUInt16(v);
-        case fmi3DataTypeUInt32:
-            return fmi3_getVariableStartUInt32(v);
-        case fmi3DataTypeUInt64:
-            return fmi3_getVariableStartUInt64(v);
         default:
             throw std::runtime_error("Illegal variable type");
     }
@@ -33,8 +27,6 @@ int32_t getStartInt(fmi3VariableHandle* v, fmi3DataType type)
 double getStartReal(fmi3VariableHandle* v, fmi3DataType type)
 {
     switch (type) {
-        case fmi3DataTypeFloat32:
-            return fmi3_getVariableStartFloat32(v);
         case fmi3DataTypeFloat64:
             return fmi3_getVariableStartFloat64(v);
         default:
@@ -84,7 +76,13 @@ std::optional<fmilibcpp::scalar_variable> to_scalar_variable(fmi3VariableHandle*
     bool hasStart = fmi3_getVariableHasStartValue(v);
 
     switch (type) {
-        case fmi3DataTypeFloat32:
+        case fmi3DataTypeFloat32: {
+            fmilibcpp::float32_attributes f{};
+            if (hasStart) {
+                f.start = fmi3_getVariableStartFloat32(v);
+            }
+            var.typeAttributes = f;
+        } break;
         case fmi3DataTypeFloat64: {
             fmilibcpp::real_attributes r{};
             if (hasStart) {
@@ -95,17 +93,36 @@ std::optional<fmilibcpp::scalar_variable> to_scalar_variable(fmi3VariableHandle*
         case fmi3DataTypeInt8:
         case fmi3DataTypeInt16:
         case fmi3DataTypeInt32:
-        case fmi3DataTypeInt64:
         case fmi3DataTypeUInt8:
-        case fmi3DataTypeUInt16:
-        case fmi3DataTypeUInt32:
-        case fmi3DataTypeUInt64: {
+        case fmi3DataTypeUInt16: {
             fmilibcpp::integer_attributes i{};
             if (hasStart) {
                 i.start = getStartInt(v, type);
             }
             var.typeAttributes = i;
         } break;
+        case fmi3DataTypeInt64: {
+            fmilibcpp::int64_attributes i{};
+            if (hasStart) {
+                i.start = fmi3_getVariableStartInt64(v);
+            }
+            var.typeAttributes = i;
+        } break;
+        case fmi3DataTypeUInt32: {
+            // exceeds int32_t, widened to int64_t like Int64
+            fmilibcpp::int64_attributes i{};
+            if (hasStart) {
+                i.start = fmi3_getVariableStartUInt32(v);
+            }
+            var.typeAttributes = i;
+        } break;
+        case fmi3DataTypeUInt64: {
+            fmilibcpp::uint64_attributes i{};
+            if (hasStart) {
+                i.start = fmi3_getVariableStartUInt64(v);
+            }
+            var.typeAttributes = i;
+        } break;
         case fmi3DataTypeBoolean: {
             fmilibcpp::boolean_attributes b{};
             if (hasStart) {
@@ -160,7 +177,7 @@ model_description create_fmi3_model_description(fmuHandle* handle)
     for (auto i = 0; i < varCount; i++) {
         const auto var = fmi3_getVariableByIndex(handle, i+1);
         if (const auto scalar = to_scalar_variable(var)) {
-            md.modelVariables.push_back(scalar.value());
+            md.add_variable(scalar.value());
         } else {
             ecos::log::warn("Variable named '{}' is of unsupported type, skipping.", fmi3_getVariableName(var));
         }
@@ -3,8 +3,11 @@
 
 #include <fmi4c.h>
 
+#include <algorithm>
 #include <cstdarg>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 
 namespace
 {
@@ -35,6 +38,123 @@ void loggerFmi3(fmi3InstanceEnvironment c,
     ecos::log::debug(ss.str());
 }
 
+std::optional<fmilibcpp::fmi3_type> to_fmi3_type(fmi3DataType type)
+{
+    switch (type) {
+        case fmi3DataTypeInt8: return fmilibcpp::fmi3_type::int8;
+        case fmi3DataTypeInt16: return fmilibcpp::fmi3_type::int16;
+        case fmi3DataTypeInt32: return fmilibcpp::fmi3_type::int32;
+        case fmi3DataTypeUInt8: return fmilibcpp::fmi3_type::uint8;
+        case fmi3DataTypeUInt16: return fmilibcpp::fmi3_type::uint16;
+        case fmi3DataTypeUInt32: return fmilibcpp::fmi3_type::uint32;
+        case fmi3DataTypeInt64: return fmilibcpp::fmi3_type::int64;
+        case fmi3DataTypeFloat64: return fmilibcpp::fmi3_type::float64;
+        default: return std::nullopt;
+    }
+}
+
+// integer and real variables map to several data types, each with its own call
+std::unordered_map<fmilibcpp::value_ref, fmilibcpp::fmi3_type> types_of(fmuHandle* handle)
+{
+    // walked by index, as looking variables up by value reference scans them
+    std::unordered_map<fmilibcpp::value_ref, fmilibcpp::fmi3_type> types;
+    const auto varCount = fmi3_getNumberOfVariables(handle);
+    types.reserve(varCount);
+    for (auto i = 0; i < varCount; i++) {
+        const auto var = fmi3_getVariableByIndex(handle, i + 1);
+        if (const auto type = to_fmi3_type(fmi3_getVariableDataType(var))) {
+            types.emplace(fmi3_getVariableValueReference(var), *type);
+        }
+    }
+    return types;
+}
+
+// The native calls of fmi3_batches
+struct fmi4c_calls
+{
+    fmi3InstanceHandle* instance;
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3Int8* values) const
+    {
+        return fmi3_getInt8(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3Int8* values) const
+    {
+        return fmi3_setInt8(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3Int16* values) const
+    {
+        return fmi3_getInt16(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3Int16* values) const
+    {
+        return fmi3_setInt16(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3Int32* values) const
+    {
+        return fmi3_getInt32(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3Int32* values) const
+    {
+        return fmi3_setInt32(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3UInt8* values) const
+    {
+        return fmi3_getUInt8(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3UInt8* values) const
+    {
+        return fmi3_setUInt8(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3UInt16* values) const
+    {
+        return fmi3_getUInt16(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3UInt16* values) const
+    {
+        return fmi3_setUInt16(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3UInt32* values) const
+    {
+        return fmi3_getUInt32(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3UInt32* values) const
+    {
+        return fmi3_setUInt32(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3Int64* values) const
+    {
+        return fmi3_getInt64(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3Int64* values) const
+    {
+        return fmi3_setInt64(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool get(const fmilibcpp::value_ref* vr, size_t n, fmi3Float64* values) const
+    {
+        return fmi3_getFloat64(instance, vr, n, values, n) == fmi3OK;
+    }
+
+    bool set(const fmilibcpp::value_ref* vr, size_t n, const fmi3Float64* values) const
+    {
+        return fmi3_setFloat64(instance, vr, n, values, n) == fmi3OK;
+    }
+};
+
 } // namespace
 
 namespace fmilibcpp
@@ -47,6 +167,7 @@ fmi3_slave::fmi3_slave(
     : slave(instanceName)
     , ctx_(ctx)
     , md_(std::move(md))
+    , batches_(instanceName, types_of(ctx_->get()))
 {
 
     instance_ = fmi3_instantiateCoSimulation(
@@ -126,67 +247,81 @@ bool fmi3_slave::reset()
 
 bool fmi3_slave::get_integer(const std::vector<value_ref>& vr, std::vector<int32_t>& values)
 {
-    fmi3Status status;
-    const auto ref = fmi3_getVariableByValueReference(ctx_->get(), vr.front());
-    switch (fmi3_getVariableDataType(ref)) {
-        case fmi3DataTypeInt8:
-            status = fmi3_getInt8(instance_, vr.data(), vr.size(), reinterpret_cast<int8_t*>(values.data()), values.size());
-            break;
-        case fmi3DataTypeInt16:
-            status = fmi3_getInt16(instance_, vr.data(), vr.size(), reinterpret_cast<int16_t*>(values.data()), values.size());
-            break;
-        case fmi3DataTypeInt32:
-            status = fmi3_getInt32(instance_, vr.data(), vr.size(), values.data(), values.size());
-            break;
-        case fmi3DataTypeInt64:
-            status = fmi3_getInt64(instance_, vr.data(), vr.size(), reinterpret_cast<int64_t*>(values.data()), values.size());
-            break;
-        default:
-            return false;
-    }
-
-    return status == fmi3OK;
+    return get_integer(std::span(vr), std::span(values));
 }
 
 bool fmi3_slave::get_real(const std::vector<value_ref>& vr, std::vector<double>& values)
 {
-
-    fmi3Status status;
-    const auto ref = fmi3_getVariableByValueReference(ctx_->get(), vr.front());
-    switch (fmi3_getVariableDataType(ref)) {
-        case fmi3DataTypeFloat32:
-            status = fmi3_getFloat32(instance_, vr.data(), vr.size(), reinterpret_cast<fmi3Float32*>(values.data()), values.size());
-            break;
-        case fmi3DataTypeFloat64:
-            status = fmi3_getFloat64(instance_, vr.data(), vr.size(), values.data(), values.size());
-            break;
-        default:
-            return false;
-    }
-
-    return status == fmi3OK;
+    return get_real(std::span(vr), std::span(values));
 }
 
 bool fmi3_slave::get_string(const std::vector<value_ref>& vr, std::vector<std::string>& values)
 {
-    auto tmp = std::vector<fmi3String>(vr.size());
-    const auto status = fmi3_getString(instance_, vr.data(), vr.size(), tmp.data(), tmp.size());
-    if (!status) return false;
+    auto tmp = std::vector<const char*>(vr.size());
+    const auto status = get_string(std::span(vr), std::span(tmp));
     for (auto i = 0; i < tmp.size(); i++) {
         values[i] = tmp[i];
     }
-    return true;
+    return status;
 }
 
 bool fmi3_slave::get_boolean(const std::vector<value_ref>& vr, std::vector<bool>& values)
 {
-    bool* tmp = new bool[values.size()];
-    std::ranges::copy(values, tmp);
-    const auto status = fmi3_getBoolean(instance_, vr.data(), vr.size(), tmp, values.size());
+    auto tmp = std::vector<uint8_t>(vr.size());
+    const auto status = get_boolean(std::span(vr), std::span(tmp));
+    for (auto i = 0; i < tmp.size(); i++) {
+        values[i] = tmp[i] != 0;
+    }
+    return status;
+}
+
+bool fmi3_slave::set_integer(const std::vector<value_ref>& vr, const std::vector<int32_t>& values)
+{
+    return set_integer(std::span(vr), std::span(values));
+}
+
+bool fmi3_slave::set_real(const std::vector<value_ref>& vr, const std::vector<double>& values)
+{
+    return set_real(std::span(vr), std::span(values));
+}
+
+bool fmi3_slave::set_string(const std::vector<value_ref>& vr, const std::vector<std::string>& values)
+{
+    std::vector<const char*> _values(vr.size());
     for (auto i = 0; i < vr.size(); i++) {
-        values[i] = tmp[i];
+        _values[i] = values[i].c_str();
     }
-    delete[] tmp;
+    return set_string(std::span(vr), std::span<const char* const>(_values));
+}
+
+bool fmi3_slave::set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values)
+{
+    std::vector<uint8_t> _values(values.begin(), values.end());
+    return set_boolean(std::span(vr), std::span<const uint8_t>(_values));
+}
+
+bool fmi3_slave::get_integer(std::span<const value_ref> vr, std::span<int32_t> values)
+{
+    fmi4c_calls calls{instance_};
+    return batches_.get(calls, vr, values);
+}
+
+bool fmi3_slave::get_real(std::span<const value_ref> vr, std::span<double> values)
+{
+    fmi4c_calls calls{instance_};
+    return batches_.get(calls, vr, values);
+}
+
+bool fmi3_slave::get_string(std::span<const value_ref> vr, std::span<const char*> values)
+{
+    const auto status = fmi3_getString(instance_, vr.data(), vr.size(), values.data(), values.size());
+    return status == fmi3OK;
+}
+
+bool fmi3_slave::get_boolean(std::span<const value_ref> vr, std::span<uint8_t> values)
+{
+    // fmi3Boolean is a bool, and shares the layout of the byte buffer
+    const auto status = fmi3_getBoolean(instance_, vr.data(), vr.size(), reinterpret_cast<fmi3Boolean*>(values.data()), values.size());
     return status == fmi3OK;
 }
 
@@ -214,99 +349,64 @@ bool fmi3_slave::get_binary(const std::vector<value_ref>& vr, std::vector<std::v
 }
 
 
-bool fmi3_slave::set_integer(const std::vector<value_ref>& vr, const std::vector<int32_t>& values)
+bool fmi3_slave::set_integer(std::span<const value_ref> vr, std::span<const int32_t> values)
 {
-    fmi3Status status;
-    const auto ref = fmi3_getVariableByValueReference(ctx_->get(), vr.front());
-    switch (fmi3_getVariableDataType(ref)) {
-        case fmi3DataTypeInt8: {
-            std::vector<fmi3Int8> int8Values(values.size());
-            std::ranges::transform(values, int8Values.begin(),
-                [](int32_t val) { return static_cast<fmi3Int8>(val); });
-            status = fmi3_setInt8(instance_, vr.data(), vr.size(), int8Values.data(), values.size());
-        } break;
-        case fmi3DataTypeInt16: {
-            std::vector<fmi3Int16> int16Values(values.size());
-            std::ranges::transform(values, int16Values.begin(),
-                [](int32_t val) { return static_cast<fmi3Int16>(val); });
-            status = fmi3_setInt16(instance_, vr.data(), vr.size(), int16Values.data(), values.size());
-        } break;
-        case fmi3DataTypeInt32: {
-            status = fmi3_setInt32(instance_, vr.data(), vr.size(), values.data(), values.size());
-        } break;
-        case fmi3DataTypeInt64: {
-            std::vector<fmi3Int64> int64Values(values.size());
-            std::ranges::transform(values, int64Values.begin(),
-                [](int64_t val) { return static_cast<fmi3Int16>(val); });
-            status = fmi3_setInt64(instance_, vr.data(), vr.size(), int64Values.data(), values.size());
-        } break;
-        case fmi3DataTypeUInt8: {
-            std::vector<fmi3UInt8> uInt8Values(values.size());
-            std::ranges::transform(values, uInt8Values.begin(),
-                [](int32_t val) { return static_cast<fmi3Int8>(val); });
-            status = fmi3_setUInt8(instance_, vr.data(), vr.size(), uInt8Values.data(), values.size());
-        } break;
-        case fmi3DataTypeUInt16: {
-            std::vector<fmi3UInt16> uInt16Values(values.size());
-            std::ranges::transform(values, uInt16Values.begin(),
-                [](int32_t val) { return static_cast<fmi3Int16>(val); });
-            status = fmi3_setUInt16(instance_, vr.data(), vr.size(), uInt16Values.data(), values.size());
-        } break;
-        case fmi3DataTypeUInt32: {
-            std::vector<fmi3UInt32> uInt32Values(values.size());
-            std::ranges::transform(values, uInt32Values.begin(),
-                [](int32_t val) { return static_cast<fmi3Int16>(val); });
-            status = fmi3_setUInt32(instance_, vr.data(), vr.size(), uInt32Values.data(), values.size());
-        } break;
-        case fmi3DataTypeUInt64: {
-            std::vector<fmi3UInt64> uInt64Values(values.size());
-            std::ranges::transform(values, uInt64Values.begin(),
-                [](int64_t val) { return static_cast<fmi3Int16>(val); });
-            status = fmi3_setUInt64(instance_, vr.data(), vr.size(), uInt64Values.data(), values.size());
-        } break;
-        default:
-            return false;
-    }
+    fmi4c_calls calls{instance_};
+    return batches_.set(calls, vr, values);
+}
+
+bool fmi3_slave::set_real(std::span<const value_ref> vr, std::span<const double> values)
+{
+    fmi4c_calls calls{instance_};
+    return batches_.set(calls, vr, values);
+}
+
+bool fmi3_slave::get_int64(std::span<const value_ref> vr, std::span<int64_t> values)
+{
+    // Int64 and UInt32 variables
+    fmi4c_calls calls{instance_};
+    return batches_.get(calls, vr, values);
+}
 
+bool fmi3_slave::get_uint64(std::span<const value_ref> vr, std::span<uint64_t> values)
+{
+    const auto status = fmi3_getUInt64(instance_, vr.data(), vr.size(), values.data(), values.size());
     return status == fmi3OK;
 }
 
-bool fmi3_slave::set_real(const std::vector<value_ref>& vr, const std::vector<double>& values)
+bool fmi3_slave::get_float32(std::span<const value_ref> vr, std::span<float> values)
 {
-    fmi3Status status;
-    const auto ref = fmi3_getVariableByValueReference(ctx_->get(), vr.front());
-    switch (fmi3_getVariableDataType(ref)) {
-        case fmi3DataTypeFloat32: {
-            std::vector<fmi3Float32> float32Values(values.size());
-            std::ranges::transform(values, float32Values.begin(),
-                [](double val) { return static_cast<fmi3Float32>(val); });
-            status = fmi3_setFloat32(instance_, vr.data(), vr.size(), float32Values.data(), float32Values.size());
-        } break;
-        case fmi3DataTypeFloat64: {
-            status = fmi3_setFloat64(instance_, vr.data(), vr.size(), values.data(), values.size());
-        } break;
-        default:
-            return false;
-    }
+    const auto status = fmi3_getFloat32(instance_, vr.data(), vr.size(), values.data(), values.size());
     return status == fmi3OK;
 }
 
-bool fmi3_slave::set_string(const std::vector<value_ref>& vr, const std::vector<std::string>& values)
+bool fmi3_slave::set_int64(std::span<const value_ref> vr, std::span<const int64_t> values)
 {
-    std::vector<fmi3String> _values(vr.size());
-    for (auto i = 0; i < vr.size(); i++) {
-        _values[i] = values[i].c_str();
-    }
-    const auto status = fmi3_setString(instance_, vr.data(), vr.size(), _values.data(), _values.size());
+    fmi4c_calls calls{instance_};
+    return batches_.set(calls, vr, values);
+}
+
+bool fmi3_slave::set_uint64(std::span<const value_ref> vr, std::span<const uint64_t> values)
+{
+    const auto status = fmi3_setUInt64(instance_, vr.data(), vr.size(), values.data(), values.size());
     return status == fmi3OK;
 }
 
-bool fmi3_slave::set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values)
+bool fmi3_slave::set_float32(std::span<const value_ref> vr, std::span<const float> values)
+{
+    const auto status = fmi3_setFloat32(instance_, vr.data(), vr.size(), values.data(), values.size());
+    return status == fmi3OK;
+}
+
+bool fmi3_slave::set_string(std::span<const value_ref> vr, std::span<const char* const> values)
+{
+    const auto status = fmi3_setString(instance_, vr.data(), vr.size(), values.data(), values.size());
+    return status == fmi3OK;
+}
+
+bool fmi3_slave::set_boolean(std::span<const value_ref> vr, std::span<const uint8_t> values)
 {
-    bool* tmp = new bool[values.size()];
-    std::ranges::copy(values, tmp);
-    const auto status = fmi3_setBoolean(instance_, vr.data(), vr.size(), tmp, values.size());
-    delete[] tmp;
+    const auto status = fmi3_setBoolean(instance_, vr.data(), vr.size(), reinterpret_cast<const fmi3Boolean*>(values.data()), values.size());
     return status == fmi3OK;
 }
 
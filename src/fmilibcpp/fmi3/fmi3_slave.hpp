@@ -2,6 +2,8 @@
 #ifndef ECOS_FMI_FMI3_SLAVE_HPP
 #define ECOS_FMI_FMI3_SLAVE_HPP
 
+#include "fmi3_batches.hpp"
+
 #include "fmilibcpp/fmicontext.hpp"
 #include "fmilibcpp/slave.hpp"
 #include "util/temp_dir.hpp"
@@ -9,6 +11,8 @@
 #include <fmi4c.h>
 
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace fmilibcpp
 {
@@ -50,6 +54,24 @@ public:
     bool set_boolean(const std::vector<value_ref>& vr, const std::vector<bool>& values) override;
     bool set_binary(const std::vector<value_ref>& vr, const std::vector<std::vector<uint8_t>>& values) override;
 
+    bool get_integer(std::span<const value_ref> vr, std::span<int32_t> values) override;
+    bool get_real(std::span<const value_ref> vr, std::span<double> values) override;
+    bool get_string(std::span<const value_ref> vr, std::span<const char*> values) override;
+    bool get_boolean(std::span<const value_ref> vr, std::span<uint8_t> values) override;
+
+    bool set_integer(std::span<const value_ref> vr, std::span<const int32_t> values) override;
+    bool set_real(std::span<const value_ref> vr, std::span<const double> values) override;
+    bool set_string(std::span<const value_ref> vr, std::span<const char* const> values) override;
+    bool set_boolean(std::span<const value_ref> vr, std::span<const uint8_t> values) override;
+
+    bool get_int64(std::span<const value_ref> vr, std::span<int64_t> values) override;
+    bool get_uint64(std::span<const value_ref> vr, std::span<uint64_t> values) override;
+    bool get_float32(std::span<const value_ref> vr, std::span<float> values) override;
+
+    bool set_int64(std::span<const value_ref> vr, std::span<const int64_t> values) override;
+    bool set_uint64(std::span<const value_ref> vr, std::span<const uint64_t> values) override;
+    bool set_float32(std::span<const value_ref> vr, std::span<const float> values) override;
+
     ~fmi3_slave() override;
 
 private:
@@ -58,6 +80,8 @@ private:
     std::shared_ptr<fmicontext> ctx_;
 
     model_description md_;
+
+    fmi3_batches batches_; // of integer and real variables
 };
 
 } // namespace fmilibcpp
@@ -15,6 +15,7 @@ class fmicontext
 {
 
 public:
+    // unzippedFmu is removed along with the context, and is null when extracted into a shared cache
     explicit fmicontext(fmuHandle* handle, std::unique_ptr<ecos::temp_dir> unzippedFmu)
         : fmuHandle_(handle)
         , unzippedFmu_(std::move(unzippedFmu))
@@ -2,6 +2,7 @@
 #include "fmi1/fmi1_fmu.hpp"
 #include "fmi2/fmi2_fmu.hpp"
 #include "fmi3/fmi3_fmu.hpp"
+#include "util/fmu_cache.hpp"
 #include "util/temp_dir.hpp"
 #include "util/unzipper.hpp"
 
@@ -17,15 +18,30 @@ std::unique_ptr<fmilibcpp::fmu> fmilibcpp::loadFmu(const std::filesystem::path&
         return nullptr;
     }
 
-    const std::string fmuName = std::filesystem::path(fmuPath).stem().string();
-    auto temp = std::make_unique<ecos::temp_dir>(fmuName);
+    // shared extractions are reused between runs, and never removed when done
+    std::filesystem::path extracted;
+    try {
+        if (const auto cache = ecos::fmu_cache::from_environment()) {
+            extracted = cache->extract(fmuPath);
+        }
+    } catch (const std::exception& ex) {
+        ecos::log::warn("FMU cache not used for '{}': {}", fmuPath.string(), ex.what());
+    }
 
-    if (!ecos::unzip(fmuPath, temp->path())) {
-        ecos::log::err("Failed to unzip '{}' to tempdir '{}'!", fmuPath.string(), temp->path().string());
-        return nullptr;
+    std::unique_ptr<ecos::temp_dir> temp;
+    if (extracted.empty()) {
+        const std::string fmuName = std::filesystem::path(fmuPath).stem().string();
+        temp = std::make_unique<ecos::temp_dir>(fmuName);
+        try {
+            ecos::unzip(fmuPath, temp->path());
+        } catch (const ecos::zip_error& ex) {
+            ecos::log::err("Failed to unzip '{}' to tempdir '{}': {}", fmuPath.string(), temp->path().string(), ex.what());
+            return nullptr;
+        }
+        extracted = temp->path();
     }
 
-    auto fmuCtx = fmi4c_loadUnzippedFmu(fmuPath.string().c_str(), temp->path().string().c_str());
+    auto fmuCtx = fmi4c_loadUnzippedFmu(fmuPath.string().c_str(), extracted.string().c_str());
     if (!fmuCtx) {
         ecos::log::err("Failed to load '{}'!", fmuPath.string());
         return nullptr;
@@ -25,6 +25,10 @@ public:
 
 std::unique_ptr<fmu> loadFmu(const std::filesystem::path& fmuPath);
 
+// Reads modelDescription.xml straight from the archive, without extracting the FMU or loading its binaries.
+// Throws if the FMU can not be read.
+model_description read_model_description(const std::filesystem::path& fmuPath);
+
 } // namespace fmilibcpp
 
 #endif // ECOS_FMI_FMU_FMU_HPP
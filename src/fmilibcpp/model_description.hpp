@@ -4,9 +4,13 @@
 
 #include "scalar_variable.hpp"
 
+#include <limits>
 #include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
-#include <algorithm>
 
 namespace fmilibcpp
 {
@@ -31,44 +35,101 @@ struct model_description
     std::string generationDateAndTime;
     bool canGetAndSetState;
 
-    model_variables modelVariables;
     default_experiment defaultExperiment;
 
-    [[nodiscard]] std::optional<scalar_variable> get_by_name(const std::string& name) const
+    // Variables in declaration order.
+    [[nodiscard]] const model_variables& variables() const
     {
-        const auto result = std::ranges::find_if(modelVariables, [&name](const scalar_variable& s) {
-            return s.name == name;
-        });
+        return modelVariables_;
+    }
 
-        if (result != modelVariables.end()) {
-            return *result;
+    void reserve_variables(size_t n)
+    {
+        modelVariables_.reserve(n);
+        nextAlias_.reserve(n);
+        byName_.reserve(n);
+        byVr_.reserve(n);
+    }
+
+    // Appends a variable, which is indexed right away such that lookups never scan the variables.
+    void add_variable(scalar_variable v)
+    {
+        const auto i = static_cast<uint32_t>(modelVariables_.size());
+        const auto key = key_of(v.typeAttributes.index(), v.vr);
+        byName_.emplace(v.name, i);
+        if (const auto [it, added] = byVr_.emplace(key, alias_chain{i, i}); !added) {
+            // variables sharing a value reference are chained in declaration order
+            nextAlias_[it->second.last] = i;
+            it->second.last = i;
         }
+        nextAlias_.emplace_back(noAlias);
+        modelVariables_.emplace_back(std::move(v));
+    }
 
-        return std::nullopt;
+    [[nodiscard]] const scalar_variable* get_by_name(const std::string& name) const
+    {
+        const auto it = byName_.find(name);
+        return it != byName_.end() ? &modelVariables_[it->second] : nullptr;
+    }
+
+    // The first declared variable of the given type (index into type_attributes) with the value reference,
+    // further variables sharing it are available from get_aliases.
+    [[nodiscard]] const scalar_variable* get_by_vr(size_t typeIndex, value_ref vr) const
+    {
+        const auto it = byVr_.find(key_of(typeIndex, vr));
+        return it != byVr_.end() ? &modelVariables_[it->second.first] : nullptr;
     }
 
     template<class T>
-    [[nodiscard]] std::optional<scalar_variable> get_by_vr(value_ref vr) const
+    [[nodiscard]] const scalar_variable* get_by_vr(value_ref vr) const
     {
-        const auto result = std::ranges::find_if(modelVariables, [&vr](const scalar_variable& s) {
-            if (std::is_same<T, int>() && s.is_integer()) {
-                return s.vr == vr;
-            } else if (std::is_same<T, double>() && s.is_real()) {
-                return s.vr == vr;
-            } else if (std::is_same<T, std::string>() && s.is_string()) {
-                return s.vr == vr;
-            } else if (std::is_same<T, bool>() && s.is_boolean()) {
-                return s.vr == vr;
-            } else {
-                return false;
-            }
-        });
-
-        if (result != modelVariables.end()) {
-            return *result;
+        if constexpr (std::is_same_v<T, int>) {
+            return get_by_vr(0, vr);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return get_by_vr(1, vr);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return get_by_vr(2, vr);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return get_by_vr(3, vr);
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            return get_by_vr(5, vr);
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            return get_by_vr(6, vr);
+        } else if constexpr (std::is_same_v<T, float>) {
+            return get_by_vr(7, vr);
+        } else {
+            return nullptr;
         }
+    }
+
+    // Every variable sharing the type and value reference of v, including v itself, in declaration order.
+    [[nodiscard]] std::vector<const scalar_variable*> get_aliases(const scalar_variable& v) const
+    {
+        std::vector<const scalar_variable*> aliases;
+        const auto it = byVr_.find(key_of(v.typeAttributes.index(), v.vr));
+        for (auto i = it != byVr_.end() ? it->second.first : noAlias; i != noAlias; i = nextAlias_[i]) {
+            aliases.emplace_back(&modelVariables_[i]);
+        }
+        return aliases;
+    }
 
-        return std::nullopt;
+private:
+    static constexpr uint32_t noAlias = std::numeric_limits<uint32_t>::max();
+
+    struct alias_chain
+    {
+        uint32_t first;
+        uint32_t last;
+    };
+
+    model_variables modelVariables_;
+    std::unordered_map<std::string, uint32_t> byName_;
+    std::unordered_map<uint64_t, alias_chain> byVr_; // (type, vr) -> first and last declared variable
+    std::vector<uint32_t> nextAlias_;                // next variable sharing the same (type, vr)
+
+    static uint64_t key_of(size_t typeIndex, value_ref vr)
+    {
+        return static_cast<uint64_t>(typeIndex) << 32 | vr;
     }
 };
 
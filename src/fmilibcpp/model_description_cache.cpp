@@ -0,0 +1,310 @@
+#include "model_description_cache.hpp"
+
+#include "util/unzipper.hpp"
+#include "util/uuid.hpp"
+
+#include <flatbuffers/flexbuffers.h>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+
+// bumped whenever the layout of the payload changes
+constexpr char magic[8] = {'e', 'c', 'o', 's', 'm', 'd', '0', '2'};
+
+struct header
+{
+    char magic[8];
+    uint32_t payloadSize;
+    uint32_t payloadCrc;
+    uint32_t fingerprintSize;
+};
+
+// read-only view of a whole file, empty if it can not be mapped
+class mapped_file
+{
+
+public:
+    explicit mapped_file(const std::filesystem::path& file)
+    {
+#ifdef _WIN32
+        const HANDLE f = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(f, &size) && size.QuadPart > 0) {
+            if (const HANDLE mapping = CreateFileMappingW(f, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                if (const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+                    data_ = static_cast<const uint8_t*>(view);
+                    size_ = static_cast<size_t>(size.QuadPart);
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(f);
+#else
+        const int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            if (const auto view = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0); view != MAP_FAILED) {
+                data_ = static_cast<const uint8_t*>(view);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    [[nodiscard]] const uint8_t* data() const
+    {
+        return data_;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return size_;
+    }
+
+    ~mapped_file()
+    {
+        if (!data_) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+
+private:
+    const uint8_t* data_{nullptr};
+    size_t size_{0};
+};
+
+std::optional<std::string> to_optional(const flexbuffers::Reference& ref)
+{
+    if (ref.IsNull()) {
+        return std::nullopt;
+    }
+    const auto str = ref.AsString();
+    return std::string(str.c_str(), str.length());
+}
+
+std::string to_string(const flexbuffers::Reference& ref)
+{
+    const auto str = ref.AsString();
+    return {str.c_str(), str.length()};
+}
+
+template<class T>
+void write_optional(flexbuffers::Builder& fbb, const std::optional<T>& value)
+{
+    if (value) {
+        fbb.Add(*value);
+    } else {
+        fbb.Null();
+    }
+}
+
+void write_variable(flexbuffers::Builder& fbb, const fmilibcpp::scalar_variable& v)
+{
+    fbb.Vector([&] {
+        fbb.UInt(v.vr);
+        fbb.String(v.name);
+        fbb.String(v.description);
+        write_optional(fbb, v.causality);
+        write_optional(fbb, v.variability);
+        fbb.UInt(v.typeAttributes.index());
+
+        switch (v.typeAttributes.index()) {
+            case 0: write_optional(fbb, std::get<fmilibcpp::integer_attributes>(v.typeAttributes).start); break;
+            case 1: write_optional(fbb, std::get<fmilibcpp::real_attributes>(v.typeAttributes).start); break;
+            case 2: write_optional(fbb, std::get<fmilibcpp::string_attributes>(v.typeAttributes).start); break;
+            case 3: write_optional(fbb, std::get<fmilibcpp::boolean_attributes>(v.typeAttributes).start); break;
+            case 5: write_optional(fbb, std::get<fmilibcpp::int64_attributes>(v.typeAttributes).start); break;
+            case 6: write_optional(fbb, std::get<fmilibcpp::uint64_attributes>(v.typeAttributes).start); break;
+            case 7: write_optional(fbb, std::get<fmilibcpp::float32_attributes>(v.typeAttributes).start); break;
+            default: fbb.Null(); break;
+        }
+    });
+}
+
+fmilibcpp::scalar_variable read_variable(const flexbuffers::Vector& fields)
+{
+    fmilibcpp::scalar_variable v;
+    v.vr = fields[0].AsUInt32();
+    v.name = to_string(fields[1]);
+    v.description = to_string(fields[2]);
+    v.causality = to_optional(fields[3]);
+    v.variability = to_optional(fields[4]);
+
+    const auto start = fields[6];
+    const bool hasStart = !start.IsNull();
+    switch (fields[5].AsUInt32()) {
+        case 0: {
+            fmilibcpp::integer_attributes a{};
+            if (hasStart) a.start = start.AsInt32();
+            v.typeAttributes = a;
+        } break;
+        case 1: {
+            fmilibcpp::real_attributes a{};
+            if (hasStart) a.start = start.AsDouble();
+            v.typeAttributes = a;
+        } break;
+        case 2: {
+            fmilibcpp::string_attributes a{};
+            if (hasStart) a.start = to_string(start);
+            v.typeAttributes = a;
+        } break;
+        case 3: {
+            fmilibcpp::boolean_attributes a{};
+            if (hasStart) a.start = start.AsBool();
+            v.typeAttributes = a;
+        } break;
+        case 4: {
+            v.typeAttributes = fmilibcpp::binary_attributes{};
+        } break;
+        case 5: {
+            fmilibcpp::int64_attributes a{};
+            if (hasStart) a.start = start.AsInt64();
+            v.typeAttributes = a;
+        } break;
+        case 6: {
+            fmilibcpp::uint64_attributes a{};
+            if (hasStart) a.start = start.AsUInt64();
+            v.typeAttributes = a;
+        } break;
+        case 7: {
+            fmilibcpp::float32_attributes a{};
+            if (hasStart) a.start = start.AsFloat();
+            v.typeAttributes = a;
+        } break;
+        default: throw std::runtime_error("Invalid variable type");
+    }
+    return v;
+}
+
+} // namespace
+
+namespace fmilibcpp
+{
+
+void save_model_description(const model_description& md, const std::filesystem::path& file, std::string_view fingerprint)
+{
+    flexbuffers::Builder fbb(1024 + md.variables().size() * 64, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+    fbb.Vector([&] {
+        fbb.String(md.guid);
+        fbb.String(md.author);
+        fbb.String(md.modelName);
+        fbb.String(md.modelIdentifier);
+        fbb.String(md.fmiVersion);
+        fbb.String(md.description);
+        fbb.String(md.generationTool);
+        fbb.String(md.generationDateAndTime);
+        fbb.Bool(md.canGetAndSetState);
+        fbb.Double(md.defaultExperiment.startTime);
+        fbb.Double(md.defaultExperiment.stopTime);
+        fbb.Double(md.defaultExperiment.tolerance);
+        fbb.Double(md.defaultExperiment.stepSize);
+        fbb.Vector([&] {
+            for (const auto& v : md.variables()) {
+                write_variable(fbb, v);
+            }
+        });
+    });
+    fbb.Finish();
+    const auto& payload = fbb.GetBuffer();
+
+    header h{};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.payloadSize = static_cast<uint32_t>(payload.size());
+    h.payloadCrc = ecos::detail::crc32(0, payload.data(), payload.size());
+    h.fingerprintSize = static_cast<uint32_t>(fingerprint.size());
+
+    // written aside and renamed into place, such that readers never see a partial file
+    auto tmp = file;
+    tmp += ".tmp-" + ecos::generate_uuid();
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(fingerprint.data(), static_cast<std::streamsize>(fingerprint.size()));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!out) {
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            throw std::runtime_error("Unable to write '" + tmp.string() + "'");
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, file, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        throw std::runtime_error("Unable to move model description into '" + file.string() + "'");
+    }
+}
+
+std::optional<model_description> load_model_description(const std::filesystem::path& file, std::string_view fingerprint)
+{
+    const mapped_file mapped(file);
+    if (mapped.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+
+    header h{};
+    std::memcpy(&h, mapped.data(), sizeof(h));
+    // sizes are checked against the file before anything beyond the header is read, e.g. if truncated
+    if (sizeof(h) + uint64_t{h.fingerprintSize} + h.payloadSize != mapped.size() ||
+        std::memcmp(h.magic, magic, sizeof(magic)) != 0 ||
+        h.fingerprintSize != fingerprint.size()) {
+        return std::nullopt;
+    }
+    const auto* fp = mapped.data() + sizeof(h);
+    const auto* payload = fp + h.fingerprintSize;
+    if (std::memcmp(fp, fingerprint.data(), fingerprint.size()) != 0 ||
+        ecos::detail::crc32(0, payload, h.payloadSize) != h.payloadCrc) {
+        return std::nullopt;
+    }
+
+    const auto root = flexbuffers::GetRoot(payload, h.payloadSize).AsVector();
+
+    model_description md;
+    md.guid = to_string(root[0]);
+    md.author = to_string(root[1]);
+    md.modelName = to_string(root[2]);
+    md.modelIdentifier = to_string(root[3]);
+    md.fmiVersion = to_string(root[4]);
+    md.description = to_string(root[5]);
+    md.generationTool = to_string(root[6]);
+    md.generationDateAndTime = to_string(root[7]);
+    md.canGetAndSetState = root[8].AsBool();
+    md.defaultExperiment.startTime = root[9].AsDouble();
+    md.defaultExperiment.stopTime = root[10].AsDouble();
+    md.defaultExperiment.tolerance = root[11].AsDouble();
+    md.defaultExperiment.stepSize = root[12].AsDouble();
+
+    const auto variables = root[13].AsVector();
+    md.reserve_variables(variables.size());
+    for (size_t i = 0; i < variables.size(); ++i) {
+        md.add_variable(read_variable(variables[i].AsVector()));
+    }
+
+    return md;
+}
+
+} // namespace fmilibcpp
@@ -0,0 +1,28 @@
+
+#ifndef ECOS_FMI_MODEL_DESCRIPTION_CACHE_HPP
+#define ECOS_FMI_MODEL_DESCRIPTION_CACHE_HPP
+
+#include "model_description.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace fmilibcpp
+{
+
+// Binary form of model descriptions, used by read_model_description (the metadata of proxied FMUs) only.
+// FMUs loaded through fmi4c still parse modelDescription.xml, and names are copied out of the mapped file
+// into the std::strings of model_description rather than viewed in place.
+
+// Writes a compact binary (flexbuffers) form of the model description,
+// tagged with a fingerprint of what it was read from.
+void save_model_description(const model_description& md, const std::filesystem::path& file, std::string_view fingerprint);
+
+// Memory-maps a model description written by save_model_description.
+// Empty if the file is missing, damaged, or was written for another fingerprint.
+std::optional<model_description> load_model_description(const std::filesystem::path& file, std::string_view fingerprint);
+
+} // namespace fmilibcpp
+
+#endif // ECOS_FMI_MODEL_DESCRIPTION_CACHE_HPP
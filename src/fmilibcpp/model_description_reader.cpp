@@ -0,0 +1,191 @@
+#include "fmu.hpp"
+#include "model_description_cache.hpp"
+
+#include "util/fmu_cache.hpp"
+#include "util/unzipper.hpp"
+
+#include "ecos/logger/logger.hpp"
+
+#include <pugixml.hpp>
+
+#include <cctype>
+
+namespace
+{
+
+// reported the way the FMI libraries do, e.g. "calculatedParameter" as "CalculatedParameter"
+std::string capitalized(const pugi::xml_attribute& attr, const char* defaultValue)
+{
+    std::string value = attr.as_string(defaultValue);
+    if (!value.empty()) {
+        value[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(value[0])));
+    }
+    return value;
+}
+
+// FMI 3.0 declares the start value of strings as <Start value=""/> children
+pugi::xml_attribute start_of(const pugi::xml_node& node)
+{
+    if (const auto start = node.attribute("start")) {
+        return start;
+    }
+    return node.child("Start").attribute("value");
+}
+
+template<class Attributes, class Get>
+Attributes typed(const pugi::xml_node& node, Get&& get)
+{
+    Attributes a{};
+    if (const auto start = start_of(node)) {
+        a.start = get(start);
+    }
+    return a;
+}
+
+std::optional<fmilibcpp::type_attributes> to_type_attributes(const pugi::xml_node& node)
+{
+    const std::string_view type = node.name();
+
+    if (type == "Real" || type == "Float64") {
+        return typed<fmilibcpp::real_attributes>(node, [](const auto& a) { return a.as_double(); });
+    }
+    if (type == "Integer" || type == "Int8" || type == "Int16" || type == "Int32" || type == "UInt8" || type == "UInt16") {
+        return typed<fmilibcpp::integer_attributes>(node, [](const auto& a) { return static_cast<int32_t>(a.as_llong()); });
+    }
+    // UInt32 exceeds int32_t, and is widened to int64_t like Int64
+    if (type == "Int64" || type == "UInt32") {
+        return typed<fmilibcpp::int64_attributes>(node, [](const auto& a) { return static_cast<int64_t>(a.as_llong()); });
+    }
+    if (type == "UInt64") {
+        return typed<fmilibcpp::uint64_attributes>(node, [](const auto& a) { return static_cast<uint64_t>(a.as_ullong()); });
+    }
+    if (type == "Float32") {
+        return typed<fmilibcpp::float32_attributes>(node, [](const auto& a) { return a.as_float(); });
+    }
+    if (type == "Boolean") {
+        return typed<fmilibcpp::boolean_attributes>(node, [](const auto& a) { return a.as_bool(); });
+    }
+    if (type == "String") {
+        return typed<fmilibcpp::string_attributes>(node, [](const auto& a) { return std::string(a.as_string()); });
+    }
+    if (type == "Binary") {
+        return fmilibcpp::binary_attributes{};
+    }
+
+    return std::nullopt;
+}
+
+std::optional<fmilibcpp::scalar_variable> to_scalar_variable(const pugi::xml_node& node, const pugi::xml_node& typeNode, bool fmi1)
+{
+    const auto attributes = to_type_attributes(typeNode);
+    if (!attributes) {
+        return std::nullopt;
+    }
+
+    fmilibcpp::scalar_variable var;
+    var.vr = node.attribute("valueReference").as_uint();
+    var.name = node.attribute("name").as_string();
+    var.description = node.attribute("description").as_string();
+    var.causality = capitalized(node.attribute("causality"), fmi1 ? "internal" : "local");
+    var.variability = capitalized(node.attribute("variability"), "continuous");
+    var.typeAttributes = *attributes;
+
+    return var;
+}
+
+fmilibcpp::model_description parse_model_description(const std::filesystem::path& fmuPath, const std::string& xml)
+{
+    pugi::xml_document doc;
+    if (const auto result = doc.load_buffer(xml.data(), xml.size()); !result) {
+        throw std::runtime_error("Failed to parse modelDescription.xml of '" + fmuPath.string() + "': " + result.description());
+    }
+
+    const auto root = doc.child("fmiModelDescription");
+    if (!root) {
+        throw std::runtime_error("'" + fmuPath.string() + "' contains no fmiModelDescription");
+    }
+
+    const std::string fmiVersion = root.attribute("fmiVersion").as_string();
+    const bool fmi1 = fmiVersion.starts_with("1.");
+    const bool fmi3 = fmiVersion.starts_with("3.");
+
+    fmilibcpp::model_description md;
+    md.fmiVersion = fmiVersion;
+    md.guid = root.attribute(fmi3 ? "instantiationToken" : "guid").as_string();
+    md.author = root.attribute("author").as_string();
+    md.modelName = root.attribute("modelName").as_string();
+    md.description = root.attribute("description").as_string();
+    md.generationTool = root.attribute("generationTool").as_string();
+    md.generationDateAndTime = root.attribute("generationDateAndTime").as_string();
+
+    if (fmi1) {
+        md.modelIdentifier = root.attribute("modelIdentifier").as_string();
+        md.canGetAndSetState = false;
+    } else {
+        const auto cs = root.child("CoSimulation");
+        if (!cs) {
+            throw std::runtime_error("'" + fmuPath.string() + "' does not support Co-Simulation");
+        }
+        md.modelIdentifier = cs.attribute("modelIdentifier").as_string();
+        md.canGetAndSetState = cs.attribute(fmi3 ? "canGetAndSetFMUState" : "canGetAndSetFMUstate").as_bool();
+    }
+
+    if (const auto ex = root.child("DefaultExperiment")) {
+        md.defaultExperiment.startTime = ex.attribute("startTime").as_double();
+        md.defaultExperiment.stopTime = ex.attribute("stopTime").as_double();
+        md.defaultExperiment.tolerance = ex.attribute("tolerance").as_double();
+        md.defaultExperiment.stepSize = ex.attribute("stepSize").as_double();
+    }
+
+    for (const auto& node : root.child("ModelVariables").children()) {
+        // FMI 1.0 and 2.0 wrap a single typed element in <ScalarVariable>, FMI 3.0 declares typed variables directly
+        const auto typeNode = fmi3 ? node : node.first_child();
+        if (const auto scalar = to_scalar_variable(node, typeNode, fmi1)) {
+            md.add_variable(scalar.value());
+        } else if (fmi3) {
+            ecos::log::warn("Variable named '{}' is of unsupported type, skipping.", node.attribute("name").as_string());
+        }
+    }
+
+    return md;
+}
+
+} // namespace
+
+namespace fmilibcpp
+{
+
+model_description read_model_description(const std::filesystem::path& fmuPath)
+{
+    const ecos::zip_archive archive(fmuPath);
+
+    const auto cache = ecos::fmu_cache::from_environment();
+    if (!cache) {
+        return parse_model_description(fmuPath, archive.read("modelDescription.xml"));
+    }
+
+    // the binary form is keyed like the extracted FMU, and fingerprinted by the model description it was read from
+    const auto entry = archive.find("modelDescription.xml");
+    if (!entry) {
+        throw ecos::zip_error(ecos::zip_errc::no_such_entry, "'" + fmuPath.string() + "' contains no modelDescription.xml");
+    }
+    const auto key = ecos::fmu_cache::key_of(archive);
+    const auto fingerprint = fmt::format("{}:{:08x}:{}", key, entry->crc32, entry->size);
+    const auto file = cache->model_description_file(key);
+
+    if (auto md = load_model_description(file, fingerprint)) {
+        ecos::log::debug("Using cached model description of '{}' at '{}'", fmuPath.string(), file.string());
+        return std::move(*md);
+    }
+
+    auto md = parse_model_description(fmuPath, archive.read("modelDescription.xml"));
+    try {
+        create_directories(cache->dir());
+        save_model_description(md, file, fingerprint);
+    } catch (const std::exception& ex) {
+        ecos::log::warn("Model description of '{}' not cached: {}", fmuPath.string(), ex.what());
+    }
+    return md;
+}
+
+} // namespace fmilibcpp
@@ -37,8 +37,24 @@ struct binary_attributes
 
 };
 
+struct int64_attributes
+{
+    std::optional<int64_t> start;
+};
+
+struct uint64_attributes
+{
+    std::optional<uint64_t> start;
+};
+
+struct float32_attributes
+{
+    std::optional<float> start;
+};
+
 using value_ref = uint32_t;
-using type_attributes = std::variant<integer_attributes, real_attributes, string_attributes, boolean_attributes, binary_attributes>;
+using type_attributes = std::variant<integer_attributes, real_attributes, string_attributes, boolean_attributes, binary_attributes,
+    int64_attributes, uint64_attributes, float32_attributes>;
 
 inline std::string type_name(const type_attributes& attribute)
 {
@@ -48,6 +64,9 @@ inline std::string type_name(const type_attributes& attribute)
         case 2: return "string";
         case 3: return "boolean";
         case 4: return "binary";
+        case 5: return "int64";
+        case 6: return "uint64";
+        case 7: return "float32";
         default: throw std::runtime_error("Invalid variant");
     }
 }
@@ -85,6 +104,21 @@ struct scalar_variable
     {
         return typeAttributes.index() == 4;
     }
+
+    [[nodiscard]] bool is_int64() const
+    {
+        return typeAttributes.index() == 5;
+    }
+
+    [[nodiscard]] bool is_uint64() const
+    {
+        return typeAttributes.index() == 6;
+    }
+
+    [[nodiscard]] bool is_float32() const
+    {
+        return typeAttributes.index() == 7;
+    }
 };
 
 using model_variables = std::vector<scalar_variable>;
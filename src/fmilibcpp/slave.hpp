@@ -6,6 +6,9 @@
 
 #include <ecos/logger/logger.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace fmilibcpp
@@ -41,30 +44,30 @@ public:
 
     int get_integer(value_ref vr)
     {
-        static std::vector<int32_t> values(1);
-        get_integer({vr}, values);
-        return values.front();
+        int32_t value{};
+        get_integer(std::span(&vr, 1), std::span(&value, 1));
+        return value;
     }
 
     double get_real(value_ref vr)
     {
-        static std::vector<double> values(1);
-        get_real({vr}, values);
-        return values.front();
+        double value{};
+        get_real(std::span(&vr, 1), std::span(&value, 1));
+        return value;
     }
 
     std::string get_string(value_ref vr)
     {
-        std::vector<std::string> values(1);
-        get_string({vr}, values);
-        return values.front();
+        const char* value{nullptr};
+        get_string(std::span(&vr, 1), std::span(&value, 1));
+        return value ? value : "";
     }
 
     bool get_boolean(value_ref vr)
     {
-        std::vector<bool> values(1);
-        get_boolean({vr}, values);
-        return values.front();
+        uint8_t value{};
+        get_boolean(std::span(&vr, 1), std::span(&value, 1));
+        return value != 0;
     }
 
     std::vector<uint8_t> get_binary(value_ref vr)
@@ -109,7 +112,98 @@ public:
         throw std::runtime_error("set_binary not implemented");
     }
 
+    // Batch accessors on caller owned buffers of FMI native layout, with booleans stored as one byte each.
+    // Slaves backed directly by an FMU pass these straight through without allocating or converting,
+    // the defaults adapt to the std::vector overloads above.
+    // Strings read are owned by the slave, and remain valid until the next call on it.
+
+    virtual bool get_integer(std::span<const value_ref> vrs, std::span<int32_t> values)
+    {
+        std::vector<int32_t> tmp(values.size());
+        const bool status = get_integer(std::vector(vrs.begin(), vrs.end()), tmp);
+        std::ranges::copy(tmp, values.begin());
+        return status;
+    }
+
+    virtual bool get_real(std::span<const value_ref> vrs, std::span<double> values)
+    {
+        std::vector<double> tmp(values.size());
+        const bool status = get_real(std::vector(vrs.begin(), vrs.end()), tmp);
+        std::ranges::copy(tmp, values.begin());
+        return status;
+    }
+
+    virtual bool get_string(std::span<const value_ref> vrs, std::span<const char*> values)
+    {
+        stringValues_.resize(values.size());
+        const bool status = get_string(std::vector(vrs.begin(), vrs.end()), stringValues_);
+        std::ranges::transform(stringValues_, values.begin(), [](const std::string& str) { return str.c_str(); });
+        return status;
+    }
+
+    virtual bool get_boolean(std::span<const value_ref> vrs, std::span<uint8_t> values)
+    {
+        std::vector<bool> tmp(values.size());
+        const bool status = get_boolean(std::vector(vrs.begin(), vrs.end()), tmp);
+        std::ranges::copy(tmp, values.begin());
+        return status;
+    }
+
+    virtual bool set_integer(std::span<const value_ref> vrs, std::span<const int32_t> values)
+    {
+        return set_integer(std::vector(vrs.begin(), vrs.end()), std::vector(values.begin(), values.end()));
+    }
+
+    virtual bool set_real(std::span<const value_ref> vrs, std::span<const double> values)
+    {
+        return set_real(std::vector(vrs.begin(), vrs.end()), std::vector(values.begin(), values.end()));
+    }
+
+    virtual bool set_string(std::span<const value_ref> vrs, std::span<const char* const> values)
+    {
+        return set_string(std::vector(vrs.begin(), vrs.end()), std::vector<std::string>(values.begin(), values.end()));
+    }
+
+    virtual bool set_boolean(std::span<const value_ref> vrs, std::span<const uint8_t> values)
+    {
+        return set_boolean(std::vector(vrs.begin(), vrs.end()), std::vector<bool>(values.begin(), values.end()));
+    }
+
+    // FMI 3 only, not supported by other slaves
+    virtual bool get_int64(std::span<const value_ref> vrs, std::span<int64_t> values)
+    {
+        throw std::runtime_error("get_int64 not implemented");
+    }
+
+    virtual bool get_uint64(std::span<const value_ref> vrs, std::span<uint64_t> values)
+    {
+        throw std::runtime_error("get_uint64 not implemented");
+    }
+
+    virtual bool get_float32(std::span<const value_ref> vrs, std::span<float> values)
+    {
+        throw std::runtime_error("get_float32 not implemented");
+    }
+
+    virtual bool set_int64(std::span<const value_ref> vrs, std::span<const int64_t> values)
+    {
+        throw std::runtime_error("set_int64 not implemented");
+    }
+
+    virtual bool set_uint64(std::span<const value_ref> vrs, std::span<const uint64_t> values)
+    {
+        throw std::runtime_error("set_uint64 not implemented");
+    }
+
+    virtual bool set_float32(std::span<const value_ref> vrs, std::span<const float> values)
+    {
+        throw std::runtime_error("set_float32 not implemented");
+    }
+
     virtual ~slave() = default;
+
+private:
+    std::vector<std::string> stringValues_;
 };
 
 } // namespace fmilibcpp
@@ -29,6 +29,14 @@ enum class opcodes
     write_string,
     write_bool,
 
+    read_int64,
+    read_uint64,
+    read_float32,
+
+    write_int64,
+    write_uint64,
+    write_float32,
+
     NONE
 
 };
@@ -66,6 +74,14 @@ inline std::string opcode_to_string(opcodes op)
         case opcodes::write_string: return "write_string";
         case opcodes::write_bool: return "write_bool";
 
+        case opcodes::read_int64: return "read_int64";
+        case opcodes::read_uint64: return "read_uint64";
+        case opcodes::read_float32: return "read_float32";
+
+        case opcodes::write_int64: return "write_int64";
+        case opcodes::write_uint64: return "write_uint64";
+        case opcodes::write_float32: return "write_float32";
+
         default: return "unknown_opcode";
     }
 }
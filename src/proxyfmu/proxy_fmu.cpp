@@ -9,19 +9,29 @@
 #include <utility>
 
 
-namespace ecos::proxy
+namespace
 {
 
-proxy_fmu::proxy_fmu(const std::filesystem::path& fmuPath, std::optional<remote_info> remote)
-    : fmuPath_(fmuPath)
-    , modelDescription_(fmilibcpp::loadFmu(fmuPath)->get_model_description())
-    , remote_(std::move(remote))
+fmilibcpp::model_description load_model_description(const std::filesystem::path& fmuPath)
 {
     if (!exists(fmuPath)) {
         throw std::runtime_error("No such file: " + absolute(fmuPath).string() + "!");
     }
+    // the FMU is loaded by each proxy process, the master only needs its metadata
+    return fmilibcpp::read_model_description(fmuPath);
 }
 
+} // namespace
+
+namespace ecos::proxy
+{
+
+proxy_fmu::proxy_fmu(const std::filesystem::path& fmuPath, std::optional<remote_info> remote)
+    : fmuPath_(fmuPath)
+    , modelDescription_(load_model_description(fmuPath))
+    , remote_(std::move(remote))
+{ }
+
 const fmilibcpp::model_description& proxy_fmu::get_model_description() const
 {
     return modelDescription_;
@@ -38,6 +38,74 @@ std::vector<uint8_t> read_data(std::string const& fileName)
     return buffer;
 }
 
+// Reads FMI 3 scalars, which are sent as typed vectors of their own width.
+template<class T>
+bool read_values(SimpleConnection& client, ecos::proxy::opcodes op, std::span<const fmilibcpp::value_ref> vr, std::span<T> values)
+{
+    assert(values.size() == vr.size());
+
+    flexbuffers::Builder fbb;
+    fbb.Vector([&] {
+        fbb.Int(enum_to_int(op));
+        fbb.Vector(vr.data(), vr.size());
+    });
+    fbb.Finish();
+    if (!client.write(fbb.GetBuffer())) {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer(512);
+    const int read = client.read(buffer.data(), buffer.size());
+
+    if (read <= 0) {
+        ecos::log::err("[{}] Failed to read data from client", opcode_to_string(op));
+        return false;
+    }
+
+    const auto root = flexbuffers::GetRoot(buffer.data(), read).AsVector();
+    const bool status = root[0].AsBool();
+    if (!status) return false;
+    const auto flexValues = root[1].AsTypedVector();
+    for (auto i = 0; i < flexValues.size(); i++) {
+        if constexpr (std::is_same_v<T, float>) {
+            values[i] = flexValues[i].AsFloat();
+        } else if constexpr (std::is_signed_v<T>) {
+            values[i] = flexValues[i].AsInt64();
+        } else {
+            values[i] = flexValues[i].AsUInt64();
+        }
+    }
+
+    return true;
+}
+
+template<class T>
+bool write_values(SimpleConnection& client, ecos::proxy::opcodes op, std::span<const fmilibcpp::value_ref> vr, std::span<const T> values)
+{
+    assert(values.size() == vr.size());
+
+    flexbuffers::Builder fbb;
+    fbb.Vector([&] {
+        fbb.Int(enum_to_int(op));
+        fbb.Vector(vr.data(), vr.size());
+        fbb.Vector(values.data(), values.size());
+    });
+    fbb.Finish();
+    if (!client.write(fbb.GetBuffer())) {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer(32);
+    const int read = client.read(buffer.data(), buffer.size());
+
+    if (read <= 0) {
+        ecos::log::err("[{}] Failed to read data from client", opcode_to_string(op));
+        return false;
+    }
+
+    return flexbuffers::GetRoot(buffer.data(), read).AsBool();
+}
+
 } // namespace
 
 
@@ -466,6 +534,36 @@ bool proxy_slave::set_boolean(const std::vector<fmilibcpp::value_ref>& vr, const
     return status;
 }
 
+bool proxy_slave::get_int64(std::span<const fmilibcpp::value_ref> vr, std::span<int64_t> values)
+{
+    return read_values(*client_, opcodes::read_int64, vr, values);
+}
+
+bool proxy_slave::get_uint64(std::span<const fmilibcpp::value_ref> vr, std::span<uint64_t> values)
+{
+    return read_values(*client_, opcodes::read_uint64, vr, values);
+}
+
+bool proxy_slave::get_float32(std::span<const fmilibcpp::value_ref> vr, std::span<float> values)
+{
+    return read_values(*client_, opcodes::read_float32, vr, values);
+}
+
+bool proxy_slave::set_int64(std::span<const fmilibcpp::value_ref> vr, std::span<const int64_t> values)
+{
+    return write_values(*client_, opcodes::write_int64, vr, values);
+}
+
+bool proxy_slave::set_uint64(std::span<const fmilibcpp::value_ref> vr, std::span<const uint64_t> values)
+{
+    return write_values(*client_, opcodes::write_uint64, vr, values);
+}
+
+bool proxy_slave::set_float32(std::span<const fmilibcpp::value_ref> vr, std::span<const float> values)
+{
+    return write_values(*client_, opcodes::write_float32, vr, values);
+}
+
 void proxy_slave::freeInstance()
 {
     if (!freed) {
@@ -10,6 +10,7 @@
 
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <thread>
 
 namespace ecos::proxy
@@ -48,6 +49,14 @@ public:
     bool set_string(const std::vector<fmilibcpp::value_ref>& vr, const std::vector<std::string>& values) override;
     bool set_boolean(const std::vector<fmilibcpp::value_ref>& vr, const std::vector<bool>& values) override;
 
+    bool get_int64(std::span<const fmilibcpp::value_ref> vr, std::span<int64_t> values) override;
+    bool get_uint64(std::span<const fmilibcpp::value_ref> vr, std::span<uint64_t> values) override;
+    bool get_float32(std::span<const fmilibcpp::value_ref> vr, std::span<float> values) override;
+
+    bool set_int64(std::span<const fmilibcpp::value_ref> vr, std::span<const int64_t> values) override;
+    bool set_uint64(std::span<const fmilibcpp::value_ref> vr, std::span<const uint64_t> values) override;
+    bool set_float32(std::span<const fmilibcpp::value_ref> vr, std::span<const float> values) override;
+
     ~proxy_slave() override;
 
 
@@ -0,0 +1,353 @@
+
+#ifndef ECOS_FMU_CACHE_HPP
+#define ECOS_FMU_CACHE_HPP
+
+#include "util/unzipper.hpp"
+#include "util/uuid.hpp"
+
+#include "ecos/logger/logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ecos
+{
+
+/**
+ * \brief Persistent, content addressed cache of extracted FMUs, shared between processes.
+ *
+ * Entries are keyed by the contents of an archive (name, size and CRC of every member), such that
+ * copies of the same FMU share a single extracted tree. Extracted trees are made read-only.
+ *
+ * An entry is populated by a single process holding <key>.lock, which extracts into a staging
+ * directory that is renamed into place once complete. Other processes wait for the entry to appear.
+ * The last use of each entry is tracked by the modification time of <key>.info.
+ * A binary form of the model description may be kept alongside as <key>.md, see model_description_file.
+ *
+ * Entries are never evicted implicitly, as another process may be using them. Exceeding the maximum size is
+ * reported as a warning, the least recently used entries are evicted by prune (`ecos cache --prune`) at a time
+ * no simulation is using the cache.
+ */
+class fmu_cache
+{
+
+public:
+    struct entry_info
+    {
+        std::string key;
+        std::filesystem::path path;
+        uint64_t size{0}; // bytes
+        std::filesystem::file_time_type lastUsed;
+        std::string source; // archive the entry was first extracted from
+    };
+
+    static constexpr uint64_t defaultMaxSize = uint64_t{10} * 1024 * 1024 * 1024;
+
+    explicit fmu_cache(std::filesystem::path dir, uint64_t maxSize = defaultMaxSize)
+        : dir_(std::move(dir))
+        , maxSize_(maxSize)
+    { }
+
+    // The cache enabled by ECOS_FMU_CACHE=<directory>, with an optional ECOS_FMU_CACHE_SIZE_MB. Empty if not enabled.
+    static std::optional<fmu_cache> from_environment()
+    {
+        const char* dir = std::getenv("ECOS_FMU_CACHE");
+        if (!dir || std::string(dir).empty()) {
+            return std::nullopt;
+        }
+        uint64_t maxSize = defaultMaxSize;
+        if (const char* size = std::getenv("ECOS_FMU_CACHE_SIZE_MB")) {
+            maxSize = std::stoull(size) * 1024 * 1024;
+        }
+        return fmu_cache(dir, maxSize);
+    }
+
+    [[nodiscard]] const std::filesystem::path& dir() const
+    {
+        return dir_;
+    }
+
+    [[nodiscard]] uint64_t max_size() const
+    {
+        return maxSize_;
+    }
+
+    static std::string key_of(const zip_archive& archive)
+    {
+        // 64-bit FNV-1a over the directory of the archive
+        uint64_t hash = 14695981039346656037ull;
+        const auto mix = [&hash](const void* data, size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ static_cast<const uint8_t*>(data)[i]) * 1099511628211ull;
+            }
+        };
+        for (const auto& e : archive.entries()) {
+            mix(e.name.data(), e.name.size() + 1);
+            mix(&e.size, sizeof(e.size));
+            mix(&e.crc32, sizeof(e.crc32));
+        }
+
+        char key[17];
+        std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+        return key;
+    }
+
+    // Directory holding the extracted contents of an FMU, which is extracted on a miss.
+    // Throws zip_error if the FMU can not be extracted, std::runtime_error if another process holds up the entry.
+    std::filesystem::path extract(const std::filesystem::path& fmuPath) const
+    {
+        const zip_archive archive(fmuPath);
+        const auto key = key_of(archive);
+        const auto entryDir = dir_ / key;
+        const auto lockFile = dir_ / (key + ".lock");
+
+        create_directories(dir_);
+
+        const auto start = std::chrono::steady_clock::now();
+        while (true) {
+            if (exists(entryDir)) {
+                touch(key);
+                log::debug("Using cached extraction of '{}' at '{}'", fmuPath.string(), entryDir.string());
+                return entryDir;
+            }
+
+            if (try_lock(lockFile)) {
+                struct unlock
+                {
+                    std::filesystem::path file;
+                    ~unlock()
+                    {
+                        std::error_code ec;
+                        remove(file, ec);
+                    }
+                } guard{lockFile};
+
+                if (!exists(entryDir)) {
+                    populate(archive, key);
+                    if (const auto total = size(); total > maxSize_) {
+                        log::warn("The FMU cache at '{}' holds {} MB, more than its maximum of {} MB. Use 'ecos cache --prune' to evict the least recently used entries.",
+                            dir_.string(), total / (1024 * 1024), maxSize_ / (1024 * 1024));
+                    }
+                }
+                touch(key);
+                return entryDir;
+            }
+
+            if (is_stale(lockFile)) {
+                log::warn("Removing stale lock '{}'", lockFile.string());
+                std::error_code ec;
+                remove(lockFile, ec);
+            } else if (std::chrono::steady_clock::now() - start > lockTimeout) {
+                throw std::runtime_error("Timed out waiting for '" + lockFile.string() + "' to be released");
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+        }
+    }
+
+    // Binary model description of the archive with the given key, which is written by fmilibcpp::read_model_description.
+    // Evicted along with the extracted entry, if any.
+    [[nodiscard]] std::filesystem::path model_description_file(const std::string& key) const
+    {
+        return dir_ / (key + ".md");
+    }
+
+    [[nodiscard]] std::vector<entry_info> list() const
+    {
+        std::vector<entry_info> entries;
+        std::error_code ec;
+        for (const auto& it : std::filesystem::directory_iterator(dir_, ec)) {
+            const auto name = it.path().filename().string();
+            if (!it.is_directory() || name.find('.') != std::string::npos) continue;
+
+            entry_info info;
+            info.key = name;
+            info.path = it.path();
+            const auto infoFile = dir_ / (name + ".info");
+            if (std::ifstream in(infoFile); in) {
+                in >> info.size;
+                in.ignore();
+                std::getline(in, info.source);
+                info.lastUsed = last_write_time(infoFile, ec);
+            } else {
+                for (const auto& f : std::filesystem::recursive_directory_iterator(it.path(), ec)) {
+                    if (f.is_regular_file()) info.size += f.file_size();
+                }
+                info.lastUsed = last_write_time(it.path(), ec);
+            }
+            entries.emplace_back(std::move(info));
+        }
+        return entries;
+    }
+
+    [[nodiscard]] uint64_t size() const
+    {
+        uint64_t size = 0;
+        for (const auto& e : list()) {
+            size += e.size;
+        }
+        return size;
+    }
+
+    // Evicts the least recently used entries (except keep) until at most maxSize bytes remain,
+    // and removes what is left behind by processes that died while populating. Returns the number of entries evicted.
+    size_t prune(uint64_t maxSize, const std::string& keep = {}) const
+    {
+        std::error_code ec;
+        for (const auto& it : std::filesystem::directory_iterator(dir_, ec)) {
+            const auto name = it.path().filename().string();
+            const bool leftover = name.find(".tmp-") != std::string::npos || name.find(".trash-") != std::string::npos ||
+                name.ends_with(".lock");
+            if (leftover && is_stale(it.path())) {
+                set_writable(it.path(), true);
+                std::filesystem::remove_all(it.path(), ec);
+            }
+        }
+
+        auto entries = list();
+        std::ranges::sort(entries, [](const entry_info& a, const entry_info& b) {
+            return a.lastUsed < b.lastUsed;
+        });
+
+        uint64_t total = 0;
+        for (const auto& e : entries) {
+            total += e.size;
+        }
+
+        size_t numEvicted = 0;
+        for (const auto& e : entries) {
+            if (total <= maxSize) break;
+            if (e.key == keep) continue;
+            if (evict(e)) {
+                total -= e.size;
+                ++numEvicted;
+            }
+        }
+        if (numEvicted > 0) {
+            log::debug("Evicted {} entries from the FMU cache at '{}', {} bytes remain", numEvicted, dir_.string(), total);
+        }
+        return numEvicted;
+    }
+
+    // Evicts every entry, and every model description. Returns the number of entries evicted.
+    size_t clear() const
+    {
+        const auto numEvicted = prune(0);
+        std::error_code ec;
+        for (const auto& it : std::filesystem::directory_iterator(dir_, ec)) {
+            if (it.path().extension() == ".md") {
+                std::filesystem::remove(it.path(), ec);
+            }
+        }
+        return numEvicted;
+    }
+
+private:
+    std::filesystem::path dir_;
+    uint64_t maxSize_;
+
+    // locks held (and staging directories left) for longer than this are abandoned
+    static constexpr auto lockTimeout = std::chrono::minutes(10);
+
+    static bool try_lock(const std::filesystem::path& lockFile)
+    {
+        // "x" fails if the file exists, making creation exclusive across processes
+        if (std::FILE* f = std::fopen(lockFile.string().c_str(), "wx")) {
+            std::fclose(f);
+            return true;
+        }
+        return false;
+    }
+
+    static bool is_stale(const std::filesystem::path& p)
+    {
+        std::error_code ec;
+        const auto modified = last_write_time(p, ec);
+        return !ec && std::filesystem::file_time_type::clock::now() - modified > lockTimeout;
+    }
+
+    // Adds (or removes) write permissions of a directory and everything below it.
+    static void set_writable(const std::filesystem::path& dir, bool writable)
+    {
+        const auto apply = [writable](const std::filesystem::path& p) {
+            std::error_code ec;
+            if (writable) {
+                std::filesystem::permissions(p, std::filesystem::perms::owner_write, std::filesystem::perm_options::add, ec);
+            } else {
+                std::filesystem::permissions(p, std::filesystem::perms::owner_write | std::filesystem::perms::group_write | std::filesystem::perms::others_write,
+                    std::filesystem::perm_options::remove, ec);
+            }
+        };
+        std::error_code ec;
+        for (const auto& it : std::filesystem::recursive_directory_iterator(dir, ec)) {
+            apply(it.path());
+        }
+        apply(dir);
+    }
+
+    void touch(const std::string& key) const
+    {
+        std::error_code ec;
+        last_write_time(dir_ / (key + ".info"), std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+    void populate(const zip_archive& archive, const std::string& key) const
+    {
+        const auto staging = dir_ / (key + ".tmp-" + generate_uuid());
+        std::error_code ec;
+        try {
+            archive.extract_all(staging);
+        } catch (...) {
+            std::filesystem::remove_all(staging, ec);
+            throw;
+        }
+
+        uint64_t size = 0;
+        for (const auto& e : archive.entries()) {
+            size += e.size;
+        }
+        std::ofstream(dir_ / (key + ".info")) << size << "\n"
+                                              << absolute(archive.path()).string() << "\n";
+        set_writable(staging, false);
+
+        // the entry appears all at once
+        std::filesystem::rename(staging, dir_ / key, ec);
+        if (ec) {
+            set_writable(staging, true);
+            std::filesystem::remove_all(staging, ec);
+            if (!exists(dir_ / key)) {
+                throw zip_error(zip_errc::io_error, "Unable to move extracted '" + archive.path().string() + "' into the cache");
+            }
+        }
+        log::info("Extracted '{}' into the FMU cache at '{}'", archive.path().string(), (dir_ / key).string());
+    }
+
+    bool evict(const entry_info& e) const
+    {
+        // moved aside first, such that no process sees a partially removed entry
+        const auto trash = dir_ / (e.key + ".trash-" + generate_uuid());
+        std::error_code ec;
+        std::filesystem::rename(e.path, trash, ec);
+        if (ec) {
+            log::warn("Unable to evict '{}' from the FMU cache: {}", e.path.string(), ec.message());
+            return false;
+        }
+        std::filesystem::remove(dir_ / (e.key + ".info"), ec);
+        std::filesystem::remove(model_description_file(e.key), ec);
+        set_writable(trash, true);
+        std::filesystem::remove_all(trash, ec);
+        return true;
+    }
+};
+
+} // namespace ecos
+
+#endif // ECOS_FMU_CACHE_HPP
@@ -0,0 +1,74 @@
+#ifndef ECOS_GRAPH_HPP
+#define ECOS_GRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ecos
+{
+
+// Strongly connected components (Tarjan) of a directed graph given as adjacency lists.
+// Components are returned in reverse topological order, i.e. after every component they have edges into.
+inline std::vector<std::vector<size_t>> strongly_connected_components(const std::vector<std::vector<size_t>>& edges)
+{
+    const size_t n = edges.size();
+    std::vector<size_t> index(n, SIZE_MAX);
+    std::vector<size_t> lowLink(n, 0);
+    std::vector<bool> onStack(n, false);
+    std::vector<size_t> stack;
+    std::vector<std::vector<size_t>> components;
+    size_t counter = 0;
+
+    // depth-first search with an explicit call stack of (vertex, next edge to follow), such that deep graphs
+    // (e.g. long chains of connected instances) can not overflow the native stack
+    std::vector<std::pair<size_t, size_t>> calls;
+
+    const auto enter = [&](size_t v) {
+        index[v] = lowLink[v] = counter++;
+        stack.emplace_back(v);
+        onStack[v] = true;
+        calls.emplace_back(v, 0);
+    };
+
+    for (size_t root = 0; root < n; ++root) {
+        if (index[root] != SIZE_MAX) continue;
+
+        enter(root);
+        while (!calls.empty()) {
+            auto& [v, next] = calls.back();
+            if (next < edges[v].size()) {
+                const auto w = edges[v][next++];
+                if (index[w] == SIZE_MAX) {
+                    enter(w); // invalidates v and next
+                } else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+                }
+                continue;
+            }
+
+            const size_t u = v;
+            calls.pop_back();
+            if (!calls.empty()) {
+                auto& parent = calls.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[u]);
+            }
+            if (lowLink[u] == index[u]) {
+                auto& component = components.emplace_back();
+                size_t w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    component.emplace_back(w);
+                } while (w != u);
+            }
+        }
+    }
+    return components;
+}
+
+} // namespace ecos
+
+#endif // ECOS_GRAPH_HPP
@@ -2,108 +2,829 @@
 #ifndef ECOS_UNZIPPER_HPP
 #define ECOS_UNZIPPER_HPP
 
-#ifdef _WIN32
-#    include <process.h>
-#else
-#    include <fcntl.h>
-#    include <sys/wait.h>
-#    include <unistd.h>
-#endif
-
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 
 namespace ecos
 {
 
+enum class zip_errc
+{
+    no_such_file,    // the archive does not exist
+    io_error,        // reading the archive or writing an extracted file failed
+    invalid_archive, // not a zip archive, or a damaged directory
+    unsupported,     // e.g. encrypted members or compression methods other than deflate
+    corrupt_data,    // compressed data that fails to inflate, or a checksum mismatch
+    unsafe_path,     // a member that would be extracted outside the target directory
+    no_such_entry,   // no member by the requested name
+};
+
+class zip_error : public std::runtime_error
+{
+
+public:
+    zip_error(zip_errc code, const std::string& msg)
+        : std::runtime_error(msg)
+        , code_(code)
+    { }
+
+    [[nodiscard]] zip_errc code() const noexcept
+    {
+        return code_;
+    }
+
+private:
+    zip_errc code_;
+};
+
 namespace detail
 {
 
-inline std::string normalize_path(std::string path)
+inline uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    static const auto table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline uint16_t read_u16(const uint8_t* p)
 {
-#ifdef _WIN32
-    std::ranges::replace(path, '\\', '/');
-    return "\"" + path + "\"";
-#else
-    return path;
-#endif
+    return static_cast<uint16_t>(p[0] | p[1] << 8);
+}
 
+inline uint32_t read_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+        static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
 }
 
-inline std::vector<std::string> make_args(const std::string& zip, const std::string& temp)
+inline uint64_t read_u64(const uint8_t* p)
 {
+    return static_cast<uint64_t>(read_u32(p)) | static_cast<uint64_t>(read_u32(p + 4)) << 32;
+}
 
-#ifdef _WIN32
-    char* shell = nullptr;
-    size_t len = 0;
-    std::string shell_str;
-    if (_dupenv_s(&shell, &len, "SHELL") == 0 && shell) {
-        shell_str = shell;
-        free(shell);
+// Receives decompressed data in order, one chunk at a time.
+using zip_sink = std::function<void(const uint8_t* data, size_t size)>;
+
+// Reads size bytes of a stream in chunks, keeping the last few bytes of the previous chunk in front of the current one.
+class chunked_input
+{
+
+public:
+    static constexpr size_t chunkSize = 64 * 1024;
+    static constexpr size_t keep = 8;
+
+    chunked_input(std::istream& in, uint64_t size)
+        : in_(in)
+        , remaining_(size)
+        , buffer_(keep + chunkSize)
+    { }
+
+    // Moves on to the next chunk, false if the end of the stream is reached.
+    bool next()
+    {
+        if (remaining_ == 0) return false;
+
+        const size_t kept = std::min(keep, end_);
+        std::memmove(buffer_.data(), buffer_.data() + end_ - kept, kept);
+        const auto n = static_cast<size_t>(std::min<uint64_t>(remaining_, chunkSize));
+        in_.read(reinterpret_cast<char*>(buffer_.data() + kept), static_cast<std::streamsize>(n));
+        if (!in_) {
+            throw zip_error(zip_errc::io_error, "Unable to read compressed data");
+        }
+        remaining_ -= n;
+        pos = kept;
+        end_ = kept + n;
+        return true;
     }
 
-    // Use unzip in Git Bash, otherwise tar
-    const bool use_unzip = shell_str.find("bash") != std::string::npos;
-#else
-    constexpr bool use_unzip = true;
-#endif
+    [[nodiscard]] const uint8_t* data() const
+    {
+        return buffer_.data();
+    }
 
-    return use_unzip
-        ? std::vector<std::string>{"unzip", "-o", normalize_path(zip), "-d", temp}
-        : std::vector<std::string>{"tar", "-xf", normalize_path(zip), "-C", temp};
-}
+    [[nodiscard]] size_t end() const
+    {
+        return end_;
+    }
+
+    size_t pos{0}; // next byte to be consumed, may be moved back by at most keep bytes
+
+private:
+    std::istream& in_;
+    uint64_t remaining_;
+    std::vector<uint8_t> buffer_;
+    size_t end_{0};
+};
 
-inline bool unzip_with_system(const std::vector<std::string>& args)
+// Decoder of raw DEFLATE streams (RFC 1951) of known decompressed size.
+// Input is read and output is handed to the sink in chunks, keeping only the 32KiB window referenced by the stream
+// in memory. Huffman codes of up to fastBits bits are decoded with a single table lookup.
+class inflater
 {
 
-    std::vector<char*> argv;
-    for (const auto& arg : args) {
-        argv.push_back(const_cast<char*>(arg.c_str()));
+public:
+    inflater(std::istream& in, uint64_t inSize, uint64_t outSize, zip_sink sink)
+        : in_(in, inSize)
+        , outSize_(outSize)
+        , window_(windowSize + flushSize)
+        , sink_(std::move(sink))
+    { }
+
+    // Returns the number of bytes written, throws zip_error on malformed input.
+    uint64_t inflate()
+    {
+        bool last = false;
+        while (!last) {
+            last = bits(1);
+            switch (bits(2)) {
+                case 0: stored(); break;
+                case 1: codes(fixed_tables().first, fixed_tables().second); break;
+                case 2: dynamic(); break;
+                default: fail("invalid block type");
+            }
+        }
+        if (overrun_ * 8 > static_cast<size_t>(bitCount_)) {
+            fail("unexpected end of data");
+        }
+        flush();
+        return written_;
+    }
+
+    // CRC-32 of the data handed to the sink so far.
+    [[nodiscard]] uint32_t crc() const
+    {
+        return crc_;
     }
-    argv.push_back(nullptr); // Null-terminate
 
+private:
+    static constexpr int fastBits = 9;
+    static constexpr int maxBits = 15;
+
+    static constexpr size_t windowSize = 32 * 1024; // furthest a match may reach back
+    static constexpr size_t flushSize = 256 * 1024;
+
+    struct huffman
+    {
+        std::array<uint16_t, 1 << fastBits> fast{}; // (length << fastBits) | symbol, 0 if longer than fastBits
+        std::array<uint16_t, maxBits + 1> firstCode{};
+        std::array<uint16_t, maxBits + 1> firstSymbol{};
+        std::array<uint32_t, maxBits + 2> maxCode{}; // left aligned to 16 bits
+        std::array<uint8_t, 288> size{};
+        std::array<uint16_t, 288> value{};
+
+        void build(const uint8_t* lengths, int n)
+        {
+            std::array<int, maxBits + 1> count{};
+            for (int i = 0; i < n; ++i) {
+                ++count[lengths[i]];
+            }
+            count[0] = 0;
+
+            std::array<int, maxBits + 1> nextCode{};
+            int code = 0;
+            int symbol = 0;
+            for (int len = 1; len <= maxBits; ++len) {
+                nextCode[len] = code;
+                firstCode[len] = static_cast<uint16_t>(code);
+                firstSymbol[len] = static_cast<uint16_t>(symbol);
+                code += count[len];
+                if (count[len] && code - 1 >= 1 << len) {
+                    throw zip_error(zip_errc::corrupt_data, "Invalid deflate data: over-subscribed code lengths");
+                }
+                maxCode[len] = static_cast<uint32_t>(code) << (16 - len);
+                code <<= 1;
+                symbol += count[len];
+            }
+            maxCode[maxBits + 1] = 0x10000;
 
-#ifdef _WIN32
-    const auto result = _spawnvp(_P_WAIT, argv[0], argv.data());
-    return result == 0;
-#else
-    pid_t pid = fork();
-    if (pid == -1) {
-        return false; // Fork failed
+            fast.fill(0);
+            for (int i = 0; i < n; ++i) {
+                const int len = lengths[i];
+                if (len == 0) continue;
+
+                const int c = nextCode[len] - firstCode[len] + firstSymbol[len];
+                size[c] = static_cast<uint8_t>(len);
+                value[c] = static_cast<uint16_t>(i);
+                if (len <= fastBits) {
+                    for (int j = reverse(nextCode[len], len); j < 1 << fastBits; j += 1 << len) {
+                        fast[j] = static_cast<uint16_t>(len << fastBits | i);
+                    }
+                }
+                ++nextCode[len];
+            }
+        }
+    };
+
+    chunked_input in_;
+    size_t overrun_{0}; // zero bytes fed past the end of the input
+
+    uint64_t outSize_;
+    uint64_t written_{0};
+    std::vector<uint8_t> window_; // the last windowSize bytes handed to the sink, followed by pending output
+    size_t pos_{0};               // end of the pending output
+    size_t pending_{0};           // start of the pending output
+    zip_sink sink_;
+    uint32_t crc_{0};
+
+    uint64_t bitBuffer_{0};
+    int bitCount_{0};
+
+    [[noreturn]] static void fail(const char* what)
+    {
+        throw zip_error(zip_errc::corrupt_data, std::string("Invalid deflate data: ") + what);
+    }
+
+    static int reverse(int code, int len)
+    {
+        int result = 0;
+        for (int i = 0; i < len; ++i) {
+            result = result << 1 | (code >> i & 1);
+        }
+        return result;
+    }
+
+    // Hands the pending output to the sink, keeping the window in front of it.
+    void flush()
+    {
+        if (pos_ == pending_) return;
+        sink_(window_.data() + pending_, pos_ - pending_);
+        crc_ = crc32(crc_, window_.data() + pending_, pos_ - pending_);
+
+        const size_t kept = std::min(pos_, windowSize);
+        std::memmove(window_.data(), window_.data() + pos_ - kept, kept);
+        pos_ = kept;
+        pending_ = kept;
+    }
+
+    // Room for size more bytes of output.
+    uint8_t* reserve(size_t size)
+    {
+        if (outSize_ - written_ < size) fail("more data than declared");
+        if (window_.size() - pos_ < size) flush();
+        return window_.data() + pos_;
+    }
+
+    void refill()
+    {
+        while (bitCount_ <= 56) {
+            uint64_t byte = 0;
+            if (in_.pos < in_.end() || in_.next()) {
+                byte = in_.data()[in_.pos++];
+            } else if (++overrun_ > 8) {
+                fail("unexpected end of data");
+            }
+            bitBuffer_ |= byte << bitCount_;
+            bitCount_ += 8;
+        }
+    }
+
+    int bits(int n)
+    {
+        if (bitCount_ < n) refill();
+        const int value = static_cast<int>(bitBuffer_ & ((uint64_t{1} << n) - 1));
+        bitBuffer_ >>= n;
+        bitCount_ -= n;
+        return value;
     }
-    if (pid == 0) {
-        // Child process
-        const int dev_null = open("/dev/null", O_WRONLY);
-        if (dev_null != -1) {
-            dup2(dev_null, STDOUT_FILENO); // Redirect stdout to /dev/null
-            dup2(dev_null, STDERR_FILENO); // Redirect stderr to /dev/null
-            close(dev_null);
+
+    int decode(const huffman& h)
+    {
+        if (bitCount_ < 16) refill();
+        if (const int entry = h.fast[bitBuffer_ & ((1 << fastBits) - 1)]) {
+            const int len = entry >> fastBits;
+            bitBuffer_ >>= len;
+            bitCount_ -= len;
+            return entry & ((1 << fastBits) - 1);
+        }
+
+        const auto k = static_cast<uint32_t>(reverse(static_cast<int>(bitBuffer_ & 0xFFFF), 16));
+        int len = fastBits + 1;
+        while (k >= h.maxCode[len]) {
+            ++len;
         }
+        if (len > maxBits) fail("invalid code");
+
+        const int c = static_cast<int>(k >> (16 - len)) - h.firstCode[len] + h.firstSymbol[len];
+        if (c < 0 || c >= 288 || h.size[c] != len) fail("invalid code");
+        bitBuffer_ >>= len;
+        bitCount_ -= len;
+        return h.value[c];
+    }
 
-        execvp(argv[0], argv.data());
-        // If execvp returns, it failed
-        std::_Exit(EXIT_FAILURE);
+    void stored()
+    {
+        // drop up to the next byte boundary, and hand back whole bytes held in the bit buffer
+        bits(bitCount_ % 8);
+        const size_t buffered = bitCount_ / 8;
+        if (overrun_ > buffered) fail("unexpected end of data");
+        in_.pos -= buffered - overrun_; // at most 8 bytes, which the input keeps around
+        bitBuffer_ = 0;
+        bitCount_ = 0;
+        overrun_ = 0;
+
+        std::array<uint8_t, 4> header{};
+        copy_input(header.data(), header.size());
+        const uint16_t len = read_u16(header.data());
+        const uint16_t nlen = read_u16(header.data() + 2);
+        if (len != static_cast<uint16_t>(~nlen)) fail("stored block length mismatch");
+
+        copy_input(reserve(len), len);
+        pos_ += len;
+        written_ += len;
+    }
+
+    void copy_input(uint8_t* dst, size_t size)
+    {
+        while (size > 0) {
+            if (in_.pos == in_.end() && !in_.next()) fail("unexpected end of data");
+            const size_t n = std::min(size, in_.end() - in_.pos);
+            std::memcpy(dst, in_.data() + in_.pos, n);
+            in_.pos += n;
+            dst += n;
+            size -= n;
+        }
     }
-    // Parent process : wait for child
-    int status = 0;
-    waitpid(pid, &status, 0);
-    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
-#endif
+
+    static const std::pair<huffman, huffman>& fixed_tables()
+    {
+        static const auto tables = [] {
+            std::array<uint8_t, 288> lengths{};
+            std::fill_n(lengths.begin(), 144, 8);
+            std::fill_n(lengths.begin() + 144, 112, 9);
+            std::fill_n(lengths.begin() + 256, 24, 7);
+            std::fill_n(lengths.begin() + 280, 8, 8);
+            std::pair<huffman, huffman> t;
+            t.first.build(lengths.data(), 288);
+            lengths.fill(5);
+            t.second.build(lengths.data(), 30);
+            return t;
+        }();
+        return tables;
+    }
+
+    void dynamic()
+    {
+        static constexpr std::array<uint8_t, 19> order{16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        const int numLengths = bits(5) + 257;
+        const int numDistances = bits(5) + 1;
+        const int numCodeLengths = bits(4) + 4;
+        if (numLengths > 286 || numDistances > 30) fail("too many codes");
+
+        std::array<uint8_t, 19> codeLengths{};
+        for (int i = 0; i < numCodeLengths; ++i) {
+            codeLengths[order[i]] = static_cast<uint8_t>(bits(3));
+        }
+        huffman codeLengthCode;
+        codeLengthCode.build(codeLengths.data(), 19);
+
+        std::array<uint8_t, 286 + 30> lengths{};
+        int n = 0;
+        while (n < numLengths + numDistances) {
+            const int symbol = decode(codeLengthCode);
+            if (symbol < 16) {
+                lengths[n++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+            uint8_t fill = 0;
+            int repeat;
+            if (symbol == 16) {
+                if (n == 0) fail("repeat without a previous length");
+                fill = lengths[n - 1];
+                repeat = 3 + bits(2);
+            } else if (symbol == 17) {
+                repeat = 3 + bits(3);
+            } else {
+                repeat = 11 + bits(7);
+            }
+            if (n + repeat > numLengths + numDistances) fail("too many code lengths");
+            std::fill_n(lengths.begin() + n, repeat, fill);
+            n += repeat;
+        }
+        if (lengths[256] == 0) fail("no end of block code");
+
+        huffman lengthCode;
+        huffman distanceCode;
+        lengthCode.build(lengths.data(), numLengths);
+        distanceCode.build(lengths.data() + numLengths, numDistances);
+        codes(lengthCode, distanceCode);
+    }
+
+    void codes(const huffman& lengthCode, const huffman& distanceCode)
+    {
+        static constexpr std::array<uint16_t, 29> lengthBase{
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static constexpr std::array<uint8_t, 29> lengthExtra{
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static constexpr std::array<uint16_t, 30> distanceBase{
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+            4097, 6145, 8193, 12289, 16385, 24577};
+        static constexpr std::array<uint8_t, 30> distanceExtra{
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        while (true) {
+            int symbol = decode(lengthCode);
+            if (symbol < 256) {
+                *reserve(1) = static_cast<uint8_t>(symbol);
+                ++pos_;
+                ++written_;
+                continue;
+            }
+            if (symbol == 256) return;
+
+            symbol -= 257;
+            if (symbol >= 29) fail("invalid length code");
+            const size_t len = lengthBase[symbol] + bits(lengthExtra[symbol]);
+
+            const int distanceSymbol = decode(distanceCode);
+            if (distanceSymbol >= 30) fail("invalid distance code");
+            const size_t distance = distanceBase[distanceSymbol] + bits(distanceExtra[distanceSymbol]);
+
+            if (distance > written_) fail("distance too far back");
+
+            // the window always holds the last windowSize bytes, which is as far back as a distance reaches
+            uint8_t* dst = reserve(len);
+            const uint8_t* src = dst - distance;
+            if (distance >= len) {
+                std::memcpy(dst, src, len);
+            } else {
+                for (size_t i = 0; i < len; ++i) {
+                    dst[i] = src[i];
+                }
+            }
+            pos_ += len;
+            written_ += len;
+        }
+    }
+};
+
+// Rejects names that are absolute or escape the directory they are extracted into.
+inline bool is_safe_entry_name(std::string_view name)
+{
+    if (name.empty() || name.front() == '/' || name.front() == '\\' || name.find(':') != std::string_view::npos) {
+        return false;
+    }
+    size_t start = 0;
+    while (start <= name.size()) {
+        size_t end = name.find_first_of("/\\", start);
+        if (end == std::string_view::npos) end = name.size();
+        if (name.substr(start, end - start) == "..") {
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
 }
+
 } // namespace detail
 
-inline bool unzip(const std::filesystem::path& zip_file, const std::filesystem::path& tmp_path)
+/**
+ * \brief Reader of zip archives, such as FMUs and SSPs.
+ *
+ * The central directory is read on construction. Members can be read into memory one at a time,
+ * or all extracted to disk in parallel. Extraction streams each member through a fixed-size window, such that
+ * memory use does not grow with the size of the members. Stored and deflated members are supported.
+ * Every error is reported as a zip_error.
+ */
+class zip_archive
 {
 
-    if (!exists(zip_file) || !exists(tmp_path)) {
-        return false;
+public:
+    struct entry
+    {
+        std::string name;
+        uint16_t method{0};
+        uint16_t flags{0};
+        uint32_t crc32{0};
+        uint64_t compressedSize{0};
+        uint64_t size{0};
+        uint64_t localHeaderOffset{0};
+        uint32_t mode{0}; // unix permissions, 0 if unknown
+
+        [[nodiscard]] bool is_directory() const
+        {
+            return !name.empty() && (name.back() == '/' || name.back() == '\\');
+        }
+    };
+
+    explicit zip_archive(std::filesystem::path path)
+        : path_(std::move(path))
+    {
+        if (!std::filesystem::exists(path_)) {
+            throw zip_error(zip_errc::no_such_file, "No such file: " + absolute(path_).string());
+        }
+        read_central_directory();
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const
+    {
+        return path_;
+    }
+
+    [[nodiscard]] const std::vector<entry>& entries() const
+    {
+        return entries_;
+    }
+
+    [[nodiscard]] const entry* find(std::string_view name) const
+    {
+        const auto it = index_.find(std::string(name));
+        return it == index_.end() ? nullptr : &entries_[it->second];
+    }
+
+    // Reads a single member, e.g. modelDescription.xml, without extracting anything to disk.
+    [[nodiscard]] std::string read(std::string_view name) const
+    {
+        const auto e = find(name);
+        if (!e) {
+            throw zip_error(zip_errc::no_such_entry, "No entry '" + std::string(name) + "' in " + path_.string());
+        }
+        std::ifstream in(path_, std::ios::binary);
+        std::string data;
+        data.reserve(static_cast<size_t>(e->size));
+        read_entry(in, *e, [&](const uint8_t* chunk, size_t size) {
+            data.append(reinterpret_cast<const char*>(chunk), size);
+        });
+        return data;
+    }
+
+    // Extracts every member into a directory, which is created if missing. Members are extracted in parallel.
+    void extract_all(const std::filesystem::path& dir) const
+    {
+        std::vector<const entry*> files;
+        std::error_code ec;
+        create_directories(dir, ec);
+        for (const auto& e : entries_) {
+            if (!detail::is_safe_entry_name(e.name)) {
+                throw zip_error(zip_errc::unsafe_path, "Refusing to extract '" + e.name + "' from " + path_.string());
+            }
+            const auto target = dir / std::filesystem::path(e.name).relative_path();
+            create_directories(e.is_directory() ? target : target.parent_path(), ec);
+            if (ec) {
+                throw zip_error(zip_errc::io_error, "Unable to create directory for '" + target.string() + "': " + ec.message());
+            }
+            if (!e.is_directory()) {
+                files.emplace_back(&e);
+            }
+        }
+
+        // largest first, such that a big member does not end up last on a single thread
+        std::ranges::sort(files, [](const entry* a, const entry* b) {
+            return a->compressedSize > b->compressedSize;
+        });
+
+        std::mutex mutex;
+        std::optional<zip_error> error;
+        std::atomic<size_t> next{0};
+        const auto work = [&] {
+            for (size_t i = next++; i < files.size(); i = next++) {
+                const entry* e = files[i];
+                try {
+                    extract(*e, dir / std::filesystem::path(e->name).relative_path());
+                } catch (const zip_error& ex) {
+                    std::lock_guard lock(mutex);
+                    if (!error) error = ex;
+                } catch (const std::exception& ex) {
+                    std::lock_guard lock(mutex);
+                    if (!error) error = zip_error(zip_errc::io_error, "Failed to extract '" + e->name + "': " + ex.what());
+                }
+            }
+        };
+
+        // plain threads rather than parallel algorithms, which would drag a TBB dependency into everything reading FMUs
+        const size_t numThreads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), files.size());
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < numThreads; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& t : workers) {
+            t.join();
+        }
+        if (error) {
+            throw *error;
+        }
+    }
+
+private:
+    std::filesystem::path path_;
+    uint64_t fileSize_{0};
+    std::vector<entry> entries_;
+    std::unordered_map<std::string, size_t> index_;
+
+    [[noreturn]] void invalid(const std::string& what) const
+    {
+        throw zip_error(zip_errc::invalid_archive, "Invalid zip archive " + path_.string() + ": " + what);
+    }
+
+    void read_at(std::ifstream& in, uint64_t offset, void* data, size_t size) const
+    {
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+        if (!in) {
+            throw zip_error(zip_errc::io_error, "Unable to read " + std::to_string(size) + " bytes at offset " +
+                    std::to_string(offset) + " of " + path_.string());
+        }
+    }
+
+    void read_central_directory()
+    {
+        std::ifstream in(path_, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw zip_error(zip_errc::io_error, "Unable to open " + path_.string());
+        }
+        const auto fileSize = static_cast<uint64_t>(in.tellg());
+        fileSize_ = fileSize;
+
+        // the end of central directory record is followed by a comment of at most 64KiB
+        constexpr size_t eocdSize = 22;
+        if (fileSize < eocdSize) invalid("too small");
+        const size_t tailSize = static_cast<size_t>(std::min<uint64_t>(fileSize, eocdSize + 0xFFFF));
+        std::vector<uint8_t> tail(tailSize);
+        read_at(in, fileSize - tailSize, tail.data(), tailSize);
+
+        std::optional<size_t> eocd;
+        for (size_t i = tailSize - eocdSize + 1; i-- > 0;) {
+            if (detail::read_u32(&tail[i]) == 0x06054b50) {
+                eocd = i;
+                break;
+            }
+        }
+        if (!eocd) invalid("no end of central directory record");
+
+        const uint8_t* p = &tail[*eocd];
+        uint64_t numEntries = detail::read_u16(p + 10);
+        uint64_t cdSize = detail::read_u32(p + 12);
+        uint64_t cdOffset = detail::read_u32(p + 16);
+
+        // zip64 locator right in front of the end of central directory record
+        const uint64_t eocdOffset = fileSize - tailSize + *eocd;
+        if (eocdOffset >= 20) {
+            std::array<uint8_t, 20> locator{};
+            read_at(in, eocdOffset - 20, locator.data(), locator.size());
+            if (detail::read_u32(locator.data()) == 0x07064b50) {
+                std::array<uint8_t, 56> eocd64{};
+                read_at(in, detail::read_u64(locator.data() + 8), eocd64.data(), eocd64.size());
+                if (detail::read_u32(eocd64.data()) != 0x06064b50) invalid("bad zip64 end of central directory record");
+                numEntries = detail::read_u64(eocd64.data() + 32);
+                cdSize = detail::read_u64(eocd64.data() + 40);
+                cdOffset = detail::read_u64(eocd64.data() + 48);
+            }
+        }
+        if (cdOffset + cdSize > fileSize) invalid("central directory out of bounds");
+
+        std::vector<uint8_t> cd(static_cast<size_t>(cdSize));
+        read_at(in, cdOffset, cd.data(), cd.size());
+
+        entries_.reserve(static_cast<size_t>(std::min<uint64_t>(numEntries, cdSize / 46)));
+        size_t pos = 0;
+        for (uint64_t i = 0; i < numEntries; ++i) {
+            if (cd.size() - pos < 46 || detail::read_u32(&cd[pos]) != 0x02014b50) invalid("bad central directory header");
+            const uint8_t* h = &cd[pos];
+            const uint16_t nameLength = detail::read_u16(h + 28);
+            const uint16_t extraLength = detail::read_u16(h + 30);
+            const uint16_t commentLength = detail::read_u16(h + 32);
+            if (cd.size() - pos < 46u + nameLength + extraLength + commentLength) invalid("truncated central directory");
+
+            entry e;
+            e.flags = detail::read_u16(h + 8);
+            e.method = detail::read_u16(h + 10);
+            e.crc32 = detail::read_u32(h + 16);
+            e.compressedSize = detail::read_u32(h + 20);
+            e.size = detail::read_u32(h + 24);
+            e.localHeaderOffset = detail::read_u32(h + 42);
+            e.name.assign(reinterpret_cast<const char*>(h + 46), nameLength);
+            if (h[5] == 3) { // made by unix
+                e.mode = detail::read_u32(h + 38) >> 16 & 0777;
+            }
+
+            // zip64 extended information, holding the values saturated above
+            const uint8_t* extra = h + 46 + nameLength;
+            for (size_t k = 0; k + 4 <= extraLength;) {
+                const uint16_t id = detail::read_u16(extra + k);
+                const uint16_t size = detail::read_u16(extra + k + 2);
+                if (k + 4 + size > extraLength) break;
+                if (id == 0x0001) {
+                    const uint8_t* field = extra + k + 4;
+                    const uint8_t* end = field + size;
+                    for (auto* value : {&e.size, &e.compressedSize, &e.localHeaderOffset}) {
+                        if (*value == 0xFFFFFFFF && end - field >= 8) {
+                            *value = detail::read_u64(field);
+                            field += 8;
+                        }
+                    }
+                }
+                k += 4 + size;
+            }
+
+            index_.emplace(e.name, entries_.size());
+            entries_.emplace_back(std::move(e));
+            pos += 46u + nameLength + extraLength + commentLength;
+        }
     }
 
-    const auto args = detail::make_args(zip_file.string(), tmp_path.string());
+    // Reads (and inflates) a member chunk by chunk into sink, checking its size and CRC on the way.
+    void read_entry(std::ifstream& in, const entry& e, const detail::zip_sink& sink) const
+    {
+        if (!in) {
+            throw zip_error(zip_errc::io_error, "Unable to open " + path_.string());
+        }
+        if (e.flags & 1) {
+            throw zip_error(zip_errc::unsupported, "Entry '" + e.name + "' is encrypted");
+        }
+        if (e.method != 0 && e.method != 8) {
+            throw zip_error(zip_errc::unsupported, "Entry '" + e.name + "' uses unsupported compression method " + std::to_string(e.method));
+        }
+
+        std::array<uint8_t, 30> local{};
+        read_at(in, e.localHeaderOffset, local.data(), local.size());
+        if (detail::read_u32(local.data()) != 0x04034b50) invalid("bad local header of '" + e.name + "'");
+        const uint64_t dataOffset = e.localHeaderOffset + 30 + detail::read_u16(local.data() + 26) + detail::read_u16(local.data() + 28);
+        // deflate expands by at most a factor of 1032, anything beyond is a damaged directory
+        if (dataOffset + e.compressedSize > fileSize_ || e.size / 1032 > e.compressedSize) {
+            invalid("bad sizes of entry '" + e.name + "'");
+        }
+
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(dataOffset));
+        uint32_t crc = 0;
+        if (e.method == 0) {
+            if (e.compressedSize != e.size) invalid("size mismatch of stored entry '" + e.name + "'");
+            detail::chunked_input input(in, e.size);
+            while (input.next()) {
+                const auto* chunk = input.data() + input.pos;
+                const size_t n = input.end() - input.pos;
+                sink(chunk, n);
+                crc = detail::crc32(crc, chunk, n);
+            }
+        } else {
+            detail::inflater inflater(in, e.compressedSize, e.size, sink);
+            if (inflater.inflate() != e.size) {
+                throw zip_error(zip_errc::corrupt_data, "Entry '" + e.name + "' is shorter than declared");
+            }
+            crc = inflater.crc();
+        }
 
-    return detail::unzip_with_system(args);
+        if (crc != e.crc32) {
+            throw zip_error(zip_errc::corrupt_data, "CRC mismatch of entry '" + e.name + "'");
+        }
+    }
+
+    void extract(const entry& e, const std::filesystem::path& target) const
+    {
+        std::ifstream in(path_, std::ios::binary);
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        read_entry(in, e, [&](const uint8_t* data, size_t size) {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        });
+        out.close();
+        if (!out) {
+            throw zip_error(zip_errc::io_error, "Unable to write " + target.string());
+        }
+
+        if (e.mode & 0111) {
+            std::error_code ec;
+            std::filesystem::permissions(target, static_cast<std::filesystem::perms>(e.mode), ec);
+        }
+    }
+};
+
+// Extracts a zip archive into a directory, throws zip_error on failure.
+inline void unzip(const std::filesystem::path& zip_file, const std::filesystem::path& tmp_path)
+{
+    zip_archive(zip_file).extract_all(tmp_path);
 }
 
 } // namespace ecos
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "ecos/algorithm/adaptive_step_algorithm.hpp"
+#include "ecos/simulation.hpp"
+
+#include <cmath>
+#include <string>
+
+using namespace ecos;
+
+namespace
+{
+
+struct integrator_state : model_state
+{
+    double input;
+    double state;
+};
+
+// Integrates its input times a gain, with support for saving and restoring its state
+class integrator_instance : public model_instance
+{
+public:
+    integrator_instance(const std::string& name, double gain, double initial, bool stateful = true)
+        : model_instance(name)
+        , gain_(gain)
+        , state_(initial)
+        , stateful_(stateful)
+    {
+        properties_.add_real_property(input_prop_);
+        properties_.add_real_property(output_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+
+    void step(double currentTime, double stepSize) override
+    {
+        state_ += gain_ * input_ * stepSize;
+        ++numSteps_;
+    }
+
+    void terminate() override { }
+    void reset() override { }
+
+    [[nodiscard]] bool can_get_and_set_state() const override
+    {
+        return stateful_;
+    }
+
+    std::unique_ptr<model_state> get_state() override
+    {
+        auto state = std::make_unique<integrator_state>();
+        state->input = input_;
+        state->state = state_;
+        return state;
+    }
+
+    void set_state(model_state& state) override
+    {
+        const auto& s = dynamic_cast<integrator_state&>(state);
+        input_ = s.input;
+        state_ = s.state;
+    }
+
+    [[nodiscard]] int num_steps() const
+    {
+        return numSteps_;
+    }
+
+private:
+    double gain_;
+    double input_{};
+    double state_;
+    bool stateful_;
+    int numSteps_{};
+
+    property_t<double> input_prop_ = property_t<double>(
+        {instanceName_, "in"},
+        [this] { return input_; },
+        [this](auto v) { input_ = v; });
+
+    property_t<double> output_prop_ = property_t<double>(
+        {instanceName_, "out"},
+        [this] { return state_; });
+};
+
+} // namespace
+
+TEST_CASE("test_adaptive_step_algorithm")
+{
+    constexpr double minStepSize = 1e-4;
+    constexpr double maxStepSize = 0.5;
+
+    auto algorithm = std::make_unique<adaptive_step_algorithm>(1e-3, minStepSize, maxStepSize, 1e-5);
+    const auto adaptive = algorithm.get();
+
+    // harmonic oscillator, x' = v, v' = -x
+    simulation sim(std::move(algorithm));
+    auto position = std::make_unique<integrator_instance>("x", 1, 1);
+    const auto x = position.get();
+    sim.add_slave(std::move(position));
+    sim.add_slave(std::make_unique<integrator_instance>("v", -1, 0));
+    sim.make_real_connection({"v", "out"}, {"x", "in"});
+    sim.make_real_connection({"x", "out"}, {"v", "in"});
+    sim.init();
+
+    int numSteps = 0;
+    while (sim.time() < 3) {
+        const double t = sim.time();
+        sim.step();
+        const double h = sim.time() - t;
+        CHECK(h >= minStepSize * (1 - 1e-12));
+        CHECK(h <= maxStepSize * (1 + 1e-12));
+        ++numSteps;
+    }
+    sim.terminate();
+
+    const double actual = sim.get_real_property({"x", "out"})->get_value();
+    CHECK_THAT(actual, Catch::Matchers::WithinAbs(std::cos(sim.time()), 1e-2));
+
+    // the step size has grown from its initial value
+    CHECK(adaptive->step_size() > 2e-3);
+    CHECK(numSteps < 3 / 1e-3);
+    // every macro step is taken as a full step and two half steps
+    CHECK(x->num_steps() >= 3 * numSteps);
+}
+
+TEST_CASE("test_adaptive_step_algorithm_deadband_rollback")
+{
+    // the first attempt of 1 is rejected, and retried at the minimum step size of 0.6
+    simulation sim(std::make_unique<adaptive_step_algorithm>(1, 0.6, 1, 1e-2));
+    sim.add_slave(std::make_unique<integrator_instance>("clock", 1, 0));
+    sim.add_slave(std::make_unique<integrator_instance>("x", 1, 0));
+    sim.add_slave(std::make_unique<integrator_instance>("y", 1, 0));
+    const auto c = sim.make_real_connection({"clock", "out"}, {"x", "in"});
+    c->set_deadband(0.25);
+    sim.make_real_connection({"x", "out"}, {"y", "in"});
+    sim.get_real_property({"clock", "in"})->set_value(1);
+    sim.init();
+
+    sim.step();
+    CHECK_THAT(sim.time(), Catch::Matchers::WithinRel(0.6));
+
+    // the clock at the middle of the accepted step (0.3) passes the deadband relative to what x held before the step,
+    // although not relative to the middle of the rejected attempt (0.5)
+    const double x = sim.get_real_property({"x", "out"})->get_value();
+    CHECK_THAT(x, Catch::Matchers::WithinAbs(0.3 * 0.3, 1e-12));
+}
+
+TEST_CASE("test_adaptive_step_algorithm_without_state")
+{
+    simulation sim(std::make_unique<adaptive_step_algorithm>(0.1, 0.01, 1));
+    sim.add_slave(std::make_unique<integrator_instance>("x", 1, 0, false));
+    sim.init();
+
+    sim.step(5);
+    CHECK_THAT(sim.time(), Catch::Matchers::WithinRel(0.5));
+}
+
+TEST_CASE("test_adaptive_step_algorithm_arguments")
+{
+    CHECK_THROWS(adaptive_step_algorithm(0.1, 0, 1));
+    CHECK_THROWS(adaptive_step_algorithm(0.1, 1, 0.5));
+    CHECK_THROWS(adaptive_step_algorithm(2, 0.1, 1));
+    CHECK_THROWS(adaptive_step_algorithm(0.1, 0.01, 1, 0));
+}
@@ -102,3 +102,32 @@ TEST_CASE("test_double_string_connection")
     CHECK_THAT(sourceValue, Catch::Matchers::WithinRel(1.));
     CHECK_THAT(std::stoi(sinkValue), Catch::Matchers::WithinRel(1.));
 }
+
+TEST_CASE("test_real_connection_deadband")
+{
+
+    double sourceValue = 0;
+    int numSets = 0;
+    property_t<double> source({"::source"}, [&] { return sourceValue; });
+    property_t<double> sink(
+        {"::sink"}, [&] { return 0.; }, [&](auto) { ++numSets; });
+
+    real_connection c{&source, &sink};
+    c.set_deadband(0.5);
+
+    for (const double value : {1., 1.2, 1.4, 1.6, 1.7, 2.0}) {
+        sourceValue = value;
+        c.transferData();
+        sink.applySet();
+    }
+
+    CHECK(numSets == 2); // 1.0 and 1.6
+    CHECK(c.num_suppressed() == 4);
+
+    c.reset_deadband();
+    c.transferData();
+    sink.applySet();
+    CHECK(numSets == 3);
+
+    CHECK_THROWS(c.set_deadband(-1));
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "ecos/connection_plan.hpp"
+
+using namespace ecos;
+
+TEST_CASE("test_connection_plan")
+{
+
+    int sourceReads = 0;
+    double sourceValue = 1;
+    double sinkValue1 = -1;
+    double sinkValue2 = -1;
+    double sinkValue3 = -1;
+    property_t<double> source({"::source"}, [&] {
+        ++sourceReads;
+        return sourceValue;
+    });
+    property_t<double> sink1(
+        {"::sink1"}, [&] { return sinkValue1; }, [&](auto value) { sinkValue1 = value; });
+    property_t<double> sink2(
+        {"::sink2"}, [&] { return sinkValue2; }, [&](auto value) { sinkValue2 = value; });
+    property_t<double> sink3(
+        {"::sink3"}, [&] { return sinkValue3; }, [&](auto value) { sinkValue3 = value; });
+
+    int intSource = 10;
+    int intSink = 0;
+    property_t<int> isource({"::isource"}, [&] { return intSource; });
+    property_t<int> isink(
+        {"::isink"}, [&] { return intSink; }, [&](auto value) { intSink = value; });
+
+    double convertSource = 5;
+    std::string convertSink;
+    property_t<double> csource({"::csource"}, [&] { return convertSource; });
+    property_t<std::string> csink(
+        {"::csink"}, [&] { return convertSink; }, [&](auto value) { convertSink = value; });
+
+    std::vector<std::unique_ptr<connection>> connections;
+    connections.emplace_back(std::make_unique<real_connection>(&source, &sink1));
+    connections.emplace_back(std::make_unique<real_connection>(&source, &sink2));
+    auto modified = std::make_unique<real_connection>(&source, &sink3);
+    modified->set_modifier([](double value) { return value * 2; });
+    connections.emplace_back(std::move(modified));
+    connections.emplace_back(std::make_unique<int_connection>(&isource, &isink));
+    connections.emplace_back(std::make_unique<connection_te<double, std::string>>(&csource, &csink, [](double value) {
+        return std::to_string(static_cast<int>(value));
+    }));
+
+    connection_plan plan;
+    plan.compile(connections);
+    REQUIRE(plan.size() == connections.size());
+
+    for (int i = 1; i <= 3; i++) {
+        sourceValue = i;
+        plan.transfer();
+        for (auto p : {&sink1, &sink2, &sink3}) {
+            p->applySet();
+        }
+        isink.applySet();
+        csink.applySet();
+
+        // fan-out from the same source only reads it once per transfer
+        CHECK(sourceReads == i);
+        CHECK_THAT(sinkValue1, Catch::Matchers::WithinRel(static_cast<double>(i)));
+        CHECK_THAT(sinkValue2, Catch::Matchers::WithinRel(static_cast<double>(i)));
+        CHECK_THAT(sinkValue3, Catch::Matchers::WithinRel(2. * i));
+    }
+
+    CHECK(intSink == 10);
+    CHECK(convertSink == "5");
+}
+
+TEST_CASE("test_connection_plan_sink_groups")
+{
+
+    double sourceValue = 1;
+    double sinkValueA = -1;
+    double sinkValueB = -1;
+    property_t<double> source({"src::out"}, [&] { return sourceValue; });
+    property_t<double> sinkA(
+        {"a::in"}, [&] { return sinkValueA; }, [&](auto value) { sinkValueA = value; });
+    property_t<double> sinkB(
+        {"b::in"}, [&] { return sinkValueB; }, [&](auto value) { sinkValueB = value; });
+
+    std::vector<std::unique_ptr<connection>> connections;
+    connections.emplace_back(std::make_unique<real_connection>(&source, &sinkA));
+    connections.emplace_back(std::make_unique<real_connection>(&source, &sinkB));
+
+    connection_plan plan;
+    plan.compile(connections, nullptr, {"src", "a", "b"});
+    REQUIRE(plan.num_groups() == 4);
+    REQUIRE(plan.size() == connections.size());
+
+    plan.transfer(1);
+    sinkA.applySet();
+    sinkB.applySet();
+    CHECK_THAT(sinkValueA, Catch::Matchers::WithinRel(1.));
+    CHECK_THAT(sinkValueB, Catch::Matchers::WithinRel(-1.));
+
+    plan.transfer(2);
+    sinkB.applySet();
+    CHECK_THAT(sinkValueB, Catch::Matchers::WithinRel(1.));
+}
@@ -0,0 +1,211 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ecos/algorithm/dataflow_algorithm.hpp"
+#include "ecos/algorithm/fixed_step_algorithm.hpp"
+#include "ecos/simulation.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ecos;
+
+namespace
+{
+
+// Integrates its input (or passes it straight through, scaled), and counts steps.
+class mock_instance : public model_instance
+{
+public:
+    mock_instance(const std::string& name, bool feedthrough, double initial, std::optional<double> stepSizeHint = std::nullopt)
+        : model_instance(name, stepSizeHint)
+        , feedthrough_(feedthrough)
+        , state_(initial)
+        , output_(initial)
+    {
+        properties_.add_real_property(input_prop_);
+        properties_.add_real_property(output_prop_);
+        properties_.add_int_property(count_in_prop_);
+        properties_.add_int_property(count_out_prop_);
+        properties_.add_bool_property(flag_prop_);
+        properties_.add_string_property(label_prop_);
+        properties_.add_int64_property(ticks_in_prop_);
+        properties_.add_int64_property(ticks_out_prop_);
+        properties_.add_uint64_property(mask_prop_);
+        properties_.add_float32_property(level_in_prop_);
+        properties_.add_float32_property(level_out_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+
+    void step(double currentTime, double stepSize) override
+    {
+        ++steps_;
+        if (!feedthrough_) {
+            state_ += (input_ - 0.5 * state_) * stepSize + currentTime * 1e-3;
+            output_ = state_;
+        }
+        countOut_ = steps_ + countIn_;
+        flag_ = !flag_;
+        label_ = std::to_string(countIn_);
+        ticksOut_ = ticksIn_ * 3 + steps_;
+        mask_ = mask_ << 1 ^ static_cast<uint64_t>(steps_);
+        levelOut_ = 0.5f * levelIn_ + static_cast<float>(steps_);
+    }
+
+    void terminate() override { }
+    void reset() override { }
+
+private:
+    bool feedthrough_;
+    double state_;
+    double input_{};
+    double output_;
+    int steps_{};
+    int countIn_{};
+    int countOut_{};
+    bool flag_{};
+    std::string label_;
+    int64_t ticksIn_{};
+    int64_t ticksOut_{};
+    uint64_t mask_{};
+    float levelIn_{};
+    float levelOut_{};
+
+    property_t<double> input_prop_ = property_t<double>(
+        {instanceName_, "in"},
+        [this] { return input_; },
+        [this](auto v) {
+            input_ = v;
+            if (feedthrough_) output_ = 0.9 * v;
+        });
+
+    property_t<double> output_prop_ = property_t<double>(
+        {instanceName_, "out"},
+        [this] { return output_; });
+
+    property_t<int> count_in_prop_ = property_t<int>(
+        {instanceName_, "count_in"},
+        [this] { return countIn_; },
+        [this](auto v) { countIn_ = v; });
+
+    property_t<int> count_out_prop_ = property_t<int>(
+        {instanceName_, "count_out"},
+        [this] { return countOut_; });
+
+    property_t<bool> flag_prop_ = property_t<bool>(
+        {instanceName_, "flag"},
+        [this] { return flag_; },
+        [this](auto v) { flag_ = v; });
+
+    property_t<std::string> label_prop_ = property_t<std::string>(
+        {instanceName_, "label"},
+        [this] { return label_; },
+        [this](auto v) { label_ = std::move(v); });
+
+    property_t<int64_t> ticks_in_prop_ = property_t<int64_t>(
+        {instanceName_, "ticks_in"},
+        [this] { return ticksIn_; },
+        [this](auto v) { ticksIn_ = v; });
+
+    property_t<int64_t> ticks_out_prop_ = property_t<int64_t>(
+        {instanceName_, "ticks_out"},
+        [this] { return ticksOut_; });
+
+    property_t<uint64_t> mask_prop_ = property_t<uint64_t>(
+        {instanceName_, "mask"},
+        [this] { return mask_; },
+        [this](auto v) { mask_ = v; });
+
+    property_t<float> level_in_prop_ = property_t<float>(
+        {instanceName_, "level_in"},
+        [this] { return levelIn_; },
+        [this](auto v) { levelIn_ = v; });
+
+    property_t<float> level_out_prop_ = property_t<float>(
+        {instanceName_, "level_out"},
+        [this] { return levelOut_; });
+};
+
+constexpr double stepSize = 0.1;
+constexpr int numInstances = 6;
+constexpr int window = 5;
+
+// A chain of alternating integrators and feedthrough instances, closed into a loop
+std::vector<double> run(std::unique_ptr<algorithm> algorithm, int numSteps, int observeEvery)
+{
+    simulation sim(std::move(algorithm));
+    sim.set_num_threads(4);
+
+    auto name = [](int i) {
+        return "m" + std::to_string(i % numInstances);
+    };
+    for (int i = 0; i < numInstances; ++i) {
+        // the last instance steps at half the rate of the others
+        const auto hint = i == numInstances - 1 ? std::optional(2 * stepSize) : std::nullopt;
+        sim.add_slave(std::make_unique<mock_instance>(name(i), i % 2 == 1, 1.0 + i, hint));
+    }
+    for (int i = 0; i < numInstances; ++i) {
+        const auto c = sim.make_real_connection({name(i), "out"}, {name(i + 1), "in"});
+        if (i == 2) {
+            c->modifier = [](double value) { return value * 0.5; };
+        }
+        if (i == 3) {
+            c->set_deadband(0.05);
+        }
+        sim.make_int_connection({name(i), "count_out"}, {name(i + 1), "count_in"});
+    }
+    sim.make_bool_connection({name(0), "flag"}, {name(3), "flag"});
+    sim.make_string_connection({name(4), "label"}, {name(1), "label"});
+    // FMI 3 types, unsupported connections would reduce the window to a single step
+    sim.make_int64_connection({name(1), "ticks_out"}, {name(2), "ticks_in"});
+    sim.make_uint64_connection({name(2), "mask"}, {name(5), "mask"});
+    sim.make_float32_connection({name(5), "level_out"}, {name(0), "level_in"});
+
+    sim.init();
+
+    std::vector<double> result;
+    for (int k = 0; k < numSteps; ++k) {
+        sim.step();
+        if ((k + 1) % observeEvery != 0) continue;
+
+        result.emplace_back(sim.time());
+        for (int i = 0; i < numInstances; ++i) {
+            result.emplace_back(sim.get_real_property({name(i), "out"})->get_value());
+            result.emplace_back(sim.get_int_property({name(i), "count_out"})->get_value());
+            result.emplace_back(sim.get_bool_property({name(i), "flag"})->get_value());
+            result.emplace_back(static_cast<double>(sim.get_string_property({name(i), "label"})->get_value().size()));
+            result.emplace_back(static_cast<double>(sim.get_int64_property({name(i), "ticks_out"})->get_value()));
+            result.emplace_back(static_cast<double>(sim.get_uint64_property({name(i), "mask"})->get_value()));
+            result.emplace_back(sim.get_float32_property({name(i), "level_out"})->get_value());
+        }
+    }
+    sim.terminate();
+
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("test_dataflow_algorithm")
+{
+    constexpr int numWindows = 40;
+    const auto expected = run(std::make_unique<fixed_step_algorithm>(stepSize), numWindows * window, window);
+
+    for (const unsigned maxRunAhead : {1, 2, 10}) {
+        const auto actual = run(std::make_unique<dataflow_algorithm>(stepSize, window, maxRunAhead), numWindows, 1);
+        // exact equality, the dataflow algorithm computes the same values in a different order
+        CHECK(actual == expected);
+    }
+
+    const auto single = run(std::make_unique<dataflow_algorithm>(stepSize, 1), numWindows * window, window);
+    CHECK(single == expected);
+}
+
+TEST_CASE("test_dataflow_algorithm_arguments")
+{
+    CHECK_THROWS(dataflow_algorithm(stepSize, 0));
+    CHECK_THROWS(dataflow_algorithm(stepSize, window, 0));
+    CHECK_THROWS(dataflow_algorithm(0, window));
+}
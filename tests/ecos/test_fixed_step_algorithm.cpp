@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ecos/algorithm/fixed_step_algorithm.hpp"
+#include "ecos/listeners/simulation_listener.hpp"
+#include "ecos/simulation.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ecos;
+
+namespace
+{
+
+// Counts its steps and the number of times its input is applied
+class counting_instance : public model_instance
+{
+public:
+    counting_instance(const std::string& name, std::optional<double> stepSizeHint)
+        : model_instance(name, stepSizeHint)
+    {
+        properties_.add_int_property(input_prop_);
+        properties_.add_int_property(output_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+
+    void step(double currentTime, double stepSize) override
+    {
+        ++numSteps_;
+    }
+
+    void terminate() override { }
+    void reset() override { }
+
+    int numSteps_{};
+    int numSets_{};
+    int input_{};
+
+private:
+    property_t<int> input_prop_ = property_t<int>(
+        {instanceName_, "in"},
+        [this] { return input_; },
+        [this](auto v) {
+            input_ = v;
+            ++numSets_;
+        });
+
+    property_t<int> output_prop_ = property_t<int>(
+        {instanceName_, "out"},
+        [this] { return numSteps_; });
+};
+
+// Output follows the input directly, without stepping
+class feedthrough_instance : public model_instance
+{
+public:
+    explicit feedthrough_instance(const std::string& name)
+        : model_instance(name, std::nullopt)
+    {
+        properties_.add_int_property(input_prop_);
+        properties_.add_int_property(output_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+    void step(double currentTime, double stepSize) override { }
+    void terminate() override { }
+    void reset() override { }
+
+private:
+    int input_{};
+
+    property_t<int> input_prop_ = property_t<int>(
+        {instanceName_, "in"},
+        [this] { return input_; },
+        [this](auto v) { input_ = v; });
+
+    property_t<int> output_prop_ = property_t<int>(
+        {instanceName_, "out"},
+        [this] { return input_; });
+};
+
+// Records the value of a variable after every step
+struct recording_listener : simulation_listener
+{
+    explicit recording_listener(variable_identifier id)
+        : id(std::move(id))
+    { }
+
+    void post_step(simulation& sim) override
+    {
+        values.emplace_back(sim.get_int_property(id)->get_value());
+    }
+
+    variable_identifier id;
+    std::vector<int> values;
+};
+
+} // namespace
+
+TEST_CASE("test_fixed_step_algorithm_schedule")
+{
+    constexpr double stepSize = 0.25;
+
+    simulation sim(std::make_unique<fixed_step_algorithm>(stepSize));
+    auto fast = std::make_unique<counting_instance>("fast", std::nullopt);
+    auto medium = std::make_unique<counting_instance>("medium", 2 * stepSize);
+    auto slow = std::make_unique<counting_instance>("slow", 3 * stepSize);
+    const auto f = fast.get();
+    const auto m = medium.get();
+    const auto s = slow.get();
+    sim.add_slave(std::move(fast));
+    sim.add_slave(std::move(medium));
+    sim.add_slave(std::move(slow));
+    sim.make_int_connection({"fast", "out"}, {"slow", "in"});
+    sim.make_int_connection({"slow", "out"}, {"medium", "in"});
+    sim.init();
+    const int initialSets = s->numSets_;
+
+    // a hyperperiod of 6 steps
+    sim.step(12);
+
+    CHECK(f->numSteps_ == 12);
+    CHECK(m->numSteps_ == 6);
+    CHECK(s->numSteps_ == 4);
+
+    // inputs are only transferred to, and applied by, instances due for a step
+    CHECK(s->numSets_ - initialSets == 3);
+    // sampled right before its last step, at step 9
+    CHECK(s->input_ == 9);
+}
+
+TEST_CASE("test_fixed_step_algorithm_set_between_ticks")
+{
+    constexpr double stepSize = 0.25;
+
+    simulation sim(std::make_unique<fixed_step_algorithm>(stepSize));
+    auto fast = std::make_unique<counting_instance>("fast", std::nullopt);
+    auto slow = std::make_unique<counting_instance>("slow", 3 * stepSize);
+    const auto s = slow.get();
+    sim.add_slave(std::move(fast));
+    sim.add_slave(std::move(slow));
+    sim.init();
+
+    sim.step(); // slow steps at step 0
+    REQUIRE(s->numSteps_ == 1);
+    const int initialSets = s->numSets_;
+
+    // set while slow is not due, applied once it is
+    sim.get_int_property({"slow", "in"})->set_value(42);
+    sim.step(2);
+    CHECK(s->numSets_ == initialSets);
+    CHECK(s->input_ == 0);
+
+    sim.step();
+    CHECK(s->numSteps_ == 2);
+    CHECK(s->numSets_ == initialSets + 1);
+    CHECK(s->input_ == 42);
+}
+
+TEST_CASE("test_fixed_step_algorithm_feedthrough_seen_by_listeners")
+{
+    simulation sim(std::make_unique<fixed_step_algorithm>(0.1));
+    auto source = std::make_unique<counting_instance>("source", std::nullopt);
+    auto feedthrough = std::make_unique<feedthrough_instance>("feedthrough");
+    const auto s = source.get();
+    sim.add_slave(std::move(source));
+    sim.add_slave(std::move(feedthrough));
+    sim.make_int_connection({"source", "out"}, {"feedthrough", "in"});
+
+    const auto recorder = std::make_shared<recording_listener>(variable_identifier{"feedthrough", "out"});
+    sim.add_listener("recorder", recorder);
+    sim.init();
+
+    sim.step(5);
+    REQUIRE(s->numSteps_ == 5);
+
+    // the input transferred after each step is only applied at the beginning of the next one,
+    // such that listeners see the feedthrough output one step behind its source
+    CHECK(recorder->values == std::vector<int>{0, 1, 2, 3, 4});
+    CHECK(sim.get_int_property({"feedthrough", "in"})->get_value() == 4);
+
+    sim.step();
+    CHECK(recorder->values.back() == 5);
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <util/fmu_cache.hpp>
+#include <util/temp_dir.hpp>
+
+#include <thread>
+
+using namespace ecos;
+
+TEST_CASE("test_fmu_cache")
+{
+    const std::filesystem::path bouncingBall = std::string(DATA_FOLDER) + "/fmus/3.0/ref/BouncingBall.fmu";
+    const std::filesystem::path identity = std::string(DATA_FOLDER) + "/fmus/1.0/identity.fmu";
+
+    temp_dir tmp("fmu_cache");
+    const fmu_cache cache(tmp.path() / "cache");
+
+    // processes (and threads) extracting the same FMU at once share a single extraction
+    std::vector<std::filesystem::path> dirs(4);
+    std::vector<std::thread> threads;
+    for (auto& dir : dirs) {
+        threads.emplace_back([&] { dir = cache.extract(bouncingBall); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (const auto& dir : dirs) {
+        CHECK(dir == dirs.front());
+    }
+    CHECK(std::filesystem::exists(dirs.front() / "modelDescription.xml"));
+    const auto permissions = std::filesystem::status(dirs.front() / "modelDescription.xml").permissions();
+    CHECK((permissions & std::filesystem::perms::owner_write) == std::filesystem::perms::none);
+
+    // copies are keyed by content
+    const auto copy = tmp.path() / "copy.fmu";
+    std::filesystem::copy_file(bouncingBall, copy);
+    CHECK(cache.extract(copy) == dirs.front());
+
+    // entries in use elsewhere are not evicted when the cache grows beyond its maximum size
+    const fmu_cache small(cache.dir(), 1);
+    const auto identityDir = small.extract(identity);
+    CHECK(identityDir != dirs.front());
+    CHECK(std::filesystem::exists(dirs.front()));
+
+    auto entries = cache.list();
+    REQUIRE(entries.size() == 2);
+    CHECK(cache.size() == entries[0].size + entries[1].size);
+
+    // least recently used first
+    cache.extract(bouncingBall);
+    const auto identitySize = identityDir == entries[0].path ? entries[0].size : entries[1].size;
+    CHECK(cache.prune(cache.size() - identitySize) == 1);
+    CHECK(!std::filesystem::exists(identityDir));
+    CHECK(std::filesystem::exists(dirs.front()));
+
+    CHECK(cache.clear() == 1);
+    CHECK(cache.list().empty());
+}
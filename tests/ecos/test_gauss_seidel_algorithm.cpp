@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "ecos/algorithm/gauss_seidel_algorithm.hpp"
+#include "ecos/simulation.hpp"
+
+#include <string>
+
+using namespace ecos;
+
+namespace
+{
+
+// Outputs its input plus one, computed when stepped
+class relay_instance : public model_instance
+{
+public:
+    explicit relay_instance(const std::string& name)
+        : model_instance(name)
+    {
+        properties_.add_real_property(input_prop_);
+        properties_.add_real_property(output_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+
+    void step(double currentTime, double stepSize) override
+    {
+        output_ = input_ + 1;
+    }
+
+    void terminate() override { }
+    void reset() override { }
+
+private:
+    double input_{};
+    double output_{};
+
+    property_t<double> input_prop_ = property_t<double>(
+        {instanceName_, "in"},
+        [this] { return input_; },
+        [this](auto v) { input_ = v; });
+
+    property_t<double> output_prop_ = property_t<double>(
+        {instanceName_, "out"},
+        [this] { return output_; });
+};
+
+double output(const simulation& sim, const std::string& instanceName)
+{
+    return sim.get_real_property({instanceName, "out"})->get_value();
+}
+
+} // namespace
+
+TEST_CASE("test_gauss_seidel_algorithm_chain")
+{
+    auto algorithm = std::make_unique<gauss_seidel_algorithm>(0.1);
+    const auto gs = algorithm.get();
+    const bool delayed = GENERATE(false, true);
+    if (delayed) {
+        gs->delay_input({"m2", "*"});
+    }
+
+    simulation sim(std::move(algorithm));
+    sim.set_num_threads(4);
+    // added in reverse, the order follows from the connections
+    for (const auto name : {"m2", "m1", "m0"}) {
+        sim.add_slave(std::make_unique<relay_instance>(name));
+    }
+    sim.make_real_connection({"m0", "out"}, {"m1", "in"});
+    sim.make_real_connection({"m1", "out"}, {"m2", "in"});
+    sim.init();
+
+    sim.step();
+    CHECK(output(sim, "m0") == 1);
+    CHECK(output(sim, "m1") == 2);
+    CHECK(output(sim, "m2") == (delayed ? 1 : 3));
+
+    sim.step();
+    CHECK(output(sim, "m2") == 3);
+}
+
+TEST_CASE("test_gauss_seidel_algorithm_cycle")
+{
+    auto algorithm = std::make_unique<gauss_seidel_algorithm>(0.1);
+    const auto gs = algorithm.get();
+    const bool prioritised = GENERATE(false, true);
+    if (prioritised) {
+        gs->set_priority("m1", 1);
+    }
+
+    simulation sim(std::move(algorithm));
+    for (const auto name : {"m0", "m1"}) {
+        sim.add_slave(std::make_unique<relay_instance>(name));
+    }
+    sim.make_real_connection({"m0", "out"}, {"m1", "in"});
+    sim.make_real_connection({"m1", "out"}, {"m0", "in"});
+    sim.init();
+
+    // the instance stepped first sees the value of the other from the previous step
+    const auto first = prioritised ? "m1" : "m0";
+    const auto second = prioritised ? "m0" : "m1";
+    for (int k = 1; k <= 5; ++k) {
+        sim.step();
+        CHECK(output(sim, first) == 2 * k - 1);
+        CHECK(output(sim, second) == 2 * k);
+    }
+}
+
+TEST_CASE("test_gauss_seidel_algorithm_wavefront")
+{
+    simulation sim(std::make_unique<gauss_seidel_algorithm>(0.1));
+    sim.set_num_threads(4);
+
+    constexpr int fanOut = 8;
+    sim.add_slave(std::make_unique<relay_instance>("source"));
+    for (int i = 0; i < fanOut; ++i) {
+        const auto name = "m" + std::to_string(i);
+        sim.add_slave(std::make_unique<relay_instance>(name));
+        sim.add_slave(std::make_unique<relay_instance>(name + "_sink"));
+        sim.make_real_connection({"source", "out"}, {name, "in"});
+        sim.make_real_connection({name, "out"}, {name + "_sink", "in"});
+    }
+    sim.init();
+
+    sim.step();
+    for (int i = 0; i < fanOut; ++i) {
+        const auto name = "m" + std::to_string(i);
+        CHECK(output(sim, name) == 2);
+        CHECK(output(sim, name + "_sink") == 3);
+    }
+}
+
+TEST_CASE("test_gauss_seidel_algorithm_transfers_once")
+{
+    simulation sim(std::make_unique<gauss_seidel_algorithm>(0.1));
+    for (const auto name : {"m0", "m1"}) {
+        sim.add_slave(std::make_unique<relay_instance>(name));
+    }
+    const auto c = sim.make_real_connection({"m0", "out"}, {"m1", "in"});
+    c->set_deadband(0.5);
+    sim.init();
+    const auto initiallySuppressed = c->num_suppressed();
+
+    sim.step(5);
+    CHECK(output(sim, "m1") == 2);
+
+    // the constant output of m0 is propagated by the first step, and held back once by each of the others,
+    // as the simulation leaves connections transferred by the algorithm alone
+    CHECK(c->num_suppressed() - initiallySuppressed == 4);
+}
@@ -0,0 +1,32 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <util/graph.hpp>
+
+using namespace ecos;
+
+TEST_CASE("test_graph_strongly_connected_components")
+{
+    // 0 -> 1 <-> 2 -> 3, 3 -> 3
+    const std::vector<std::vector<size_t>> edges{{1}, {2}, {1, 3}, {3}};
+    const auto components = strongly_connected_components(edges);
+
+    // components follow every component they have edges into
+    REQUIRE(components.size() == 3);
+    CHECK(components[0] == std::vector<size_t>{3});
+    CHECK(components[1] == std::vector<size_t>{2, 1});
+    CHECK(components[2] == std::vector<size_t>{0});
+}
+
+TEST_CASE("test_graph_deep_cycle")
+{
+    // deep enough to overflow the stack if searched recursively
+    constexpr size_t n = 1'000'000;
+    std::vector<std::vector<size_t>> edges(n);
+    for (size_t i = 0; i < n; ++i) {
+        edges[i].emplace_back((i + 1) % n);
+    }
+
+    const auto components = strongly_connected_components(edges);
+    REQUIRE(components.size() == 1);
+    CHECK(components[0].size() == n);
+}
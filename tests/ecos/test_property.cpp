@@ -1,10 +1,57 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <ecos/property.hpp>
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 using namespace ecos;
 
+namespace
+{
+
+template<class T>
+struct test_buffer : value_buffer<T>
+{
+    explicit test_buffer(size_t size)
+        : data(size)
+        , updatedAt(size, 0)
+    {
+        this->values = data.data();
+        this->fetchedAt = updatedAt.data();
+        this->generation = &currentGeneration;
+    }
+
+    void subscribe(size_t slot) override
+    {
+        subscribed.emplace_back(slot);
+    }
+
+    void refresh(size_t slot) override
+    {
+        refreshed.emplace_back(slot);
+        updatedAt[slot] = currentGeneration;
+    }
+
+    void set(size_t slot, const T& value) override
+    {
+        data[slot] = value;
+        ++numSets;
+    }
+
+    std::vector<typename value_buffer<T>::stored_type> data;
+    std::vector<uint64_t> updatedAt;
+    uint64_t currentGeneration{1};
+    std::vector<size_t> subscribed;
+    std::vector<size_t> refreshed;
+    int numSets{};
+};
+
+} // namespace
+
 TEST_CASE("test_property")
 {
     SECTION("test int"){
@@ -38,3 +85,103 @@ TEST_CASE("test_property")
         CHECK_THAT(value,Catch::Matchers::WithinRel(-101.));
     }
 }
+
+TEST_CASE("test_buffered_property")
+{
+    SECTION("test double")
+    {
+        test_buffer<double> buffer(3);
+        buffer.data[1] = 2;
+        property_t<double> p({"::doubleValue"}, buffer, 1);
+
+        CHECK(p.get_value() == 2);
+        CHECK(p.get_value() == 2);
+        // refreshed once outdated only
+        REQUIRE(buffer.refreshed.size() == 1);
+        CHECK(buffer.refreshed.front() == 1);
+        ++buffer.currentGeneration;
+        CHECK(p.get_value() == 2);
+        CHECK(buffer.refreshed.size() == 2);
+
+        p.subscribe();
+        REQUIRE(buffer.subscribed.size() == 1);
+        CHECK(buffer.subscribed.front() == 1);
+
+        p.set_value(3);
+        CHECK(buffer.numSets == 0);
+        p.applySet();
+        CHECK(buffer.numSets == 1);
+        CHECK(p.get_value() == 3);
+
+        p.set_output_modifier([](double v) { return 2 * v; });
+        p.set_input_modifier([](double v) { return v + 1; });
+        CHECK(p.get_value() == 6);
+        p.set_value(4);
+        p.applySet();
+        CHECK(buffer.data[1] == 5);
+        CHECK(p.get_value() == 10);
+    }
+
+    SECTION("test bool")
+    {
+        test_buffer<bool> buffer(2);
+        property_t<bool> p({"::boolValue"}, buffer, 0);
+
+        CHECK_FALSE(p.get_value());
+        p.set_value(true);
+        p.applySet();
+        CHECK(buffer.data[0] == 1);
+        CHECK(p.get_value());
+    }
+}
+
+TEST_CASE("benchmark_property", "[.][benchmark]")
+{
+    constexpr size_t numVariables = 100;
+
+    // function backed, looking up the slot of a value reference and checking whether it is being fetched,
+    // as done by property getters going through fmilibcpp::buffered_slave::get_real
+    std::vector<double> values(numVariables, 1.0);
+    std::unordered_map<uint32_t, size_t> slots;
+    std::vector<uint32_t> fetched;
+    for (uint32_t vr = 0; vr < numVariables; ++vr) {
+        slots.emplace(vr, vr);
+        fetched.emplace_back(vr);
+    }
+    const uint32_t vr = numVariables / 2;
+    property_t<double> function(
+        {"::function"},
+        [&] {
+            const size_t slot = slots.at(vr);
+            if (std::ranges::find(fetched, vr) == fetched.end()) {
+                fetched.emplace_back(vr);
+            }
+            return values[slot];
+        },
+        [&](auto v) { values[slots.at(vr)] = v; });
+
+    test_buffer<double> buffer(numVariables);
+    property_t<double> buffered({"::buffered"}, buffer, vr);
+
+    BENCHMARK("get_value, function")
+    {
+        return function.get_value();
+    };
+
+    BENCHMARK("get_value, buffered")
+    {
+        return buffered.get_value();
+    };
+
+    BENCHMARK("set_value + applySet, function")
+    {
+        function.set_value(2);
+        function.applySet();
+    };
+
+    BENCHMARK("set_value + applySet, buffered")
+    {
+        buffered.set_value(2);
+        buffered.applySet();
+    };
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "ecos/algorithm/fixed_step_algorithm.hpp"
+#include "ecos/simulation.hpp"
+
+#include <algorithm>
+#include <string>
+
+using namespace ecos;
+
+namespace
+{
+
+// Output is an affine function of the input (direct feedthrough)
+class affine_instance : public model_instance
+{
+public:
+    affine_instance(const std::string& name, double gain, double offset)
+        : model_instance(name)
+        , gain_(gain)
+        , offset_(offset)
+        , output_(offset)
+    {
+        properties_.add_real_property(input_prop_);
+        properties_.add_real_property(output_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+    void step(double currentTime, double stepSize) override { }
+    void terminate() override { }
+    void reset() override { }
+
+    int numSets_{};
+
+private:
+    double gain_;
+    double offset_;
+    double output_;
+
+    property_t<double> input_prop_ = property_t<double>(
+        {instanceName_, "in"},
+        [this] { return (output_ - offset_) / gain_; },
+        [this](auto v) {
+            output_ = gain_ * v + offset_;
+            ++numSets_;
+        });
+
+    property_t<double> output_prop_ = property_t<double>(
+        {instanceName_, "out"},
+        [this] { return output_; });
+};
+
+// Output is the input plus one, saturating at a limit (64-bit integers)
+class counter_instance : public model_instance
+{
+public:
+    counter_instance(const std::string& name, int64_t limit)
+        : model_instance(name)
+        , limit_(limit)
+    {
+        properties_.add_int64_property(input_prop_);
+        properties_.add_int64_property(output_prop_);
+    }
+
+    void set_debug_logging(bool flag) override { }
+    void enter_initialization_mode(double start) override { }
+    void exit_initialization_mode() override { }
+    void step(double currentTime, double stepSize) override { }
+    void terminate() override { }
+    void reset() override { }
+
+private:
+    int64_t limit_;
+    int64_t input_{0};
+
+    property_t<int64_t> input_prop_ = property_t<int64_t>(
+        {instanceName_, "in"},
+        [this] { return input_; },
+        [this](auto v) { input_ = v; });
+
+    property_t<int64_t> output_prop_ = property_t<int64_t>(
+        {instanceName_, "out"},
+        [this] { return std::min(input_ + 1, limit_); });
+};
+
+double output(const simulation& sim, const std::string& instanceName)
+{
+    return sim.get_real_property({instanceName, "out"})->get_value();
+}
+
+} // namespace
+
+TEST_CASE("test_simulation_init_chain")
+{
+    constexpr int length = 20;
+
+    simulation sim(std::make_unique<fixed_step_algorithm>(0.1));
+    std::vector<affine_instance*> instances;
+    // added in reverse, the initialization order follows from the connections
+    for (int i = length - 1; i >= 0; --i) {
+        auto instance = std::make_unique<affine_instance>("m" + std::to_string(i), 1, 1);
+        instances.emplace_back(instance.get());
+        sim.add_slave(std::move(instance));
+    }
+    for (int i = 0; i + 1 < length; ++i) {
+        sim.make_real_connection({"m" + std::to_string(i), "out"}, {"m" + std::to_string(i + 1), "in"});
+    }
+    sim.init();
+
+    CHECK(output(sim, "m" + std::to_string(length - 1)) == length);
+    // every input is set a bounded number of times, rather than once per instance
+    for (const auto instance : instances) {
+        CHECK(instance->numSets_ <= 3);
+    }
+}
+
+TEST_CASE("test_simulation_init_cycle")
+{
+    simulation sim(std::make_unique<fixed_step_algorithm>(0.1));
+    sim.add_slave(std::make_unique<affine_instance>("a", 0.5, 1));
+    sim.add_slave(std::make_unique<affine_instance>("b", 1, 0));
+    sim.make_real_connection({"a", "out"}, {"b", "in"});
+    sim.make_real_connection({"b", "out"}, {"a", "in"});
+
+    SECTION("converges")
+    {
+        sim.set_init_tolerance(1e-12);
+        sim.init();
+        // fixed point of x = 0.5 * x + 1
+        CHECK_THAT(output(sim, "a"), Catch::Matchers::WithinRel(2., 1e-9));
+        CHECK_THAT(output(sim, "b"), Catch::Matchers::WithinRel(2., 1e-9));
+    }
+
+    SECTION("iteration cap")
+    {
+        sim.set_init_tolerance(1e-12, 3);
+        sim.init();
+        CHECK(output(sim, "a") < 2 - 1e-3);
+    }
+
+    CHECK_THROWS(sim.set_init_tolerance(-1));
+    CHECK_THROWS(sim.set_init_tolerance(1e-6, 0));
+}
+
+TEST_CASE("test_simulation_init_cycle_int64")
+{
+    simulation sim(std::make_unique<fixed_step_algorithm>(0.1));
+    sim.add_slave(std::make_unique<counter_instance>("a", 10));
+    sim.add_slave(std::make_unique<counter_instance>("b", 10));
+    sim.make_int64_connection({"a", "out"}, {"b", "in"});
+    sim.make_int64_connection({"b", "out"}, {"a", "in"});
+    sim.init();
+
+    // iterated until the outputs stop changing, rather than taken as converged after the first pass
+    CHECK(sim.get_int64_property({"a", "out"})->get_value() == 10);
+    CHECK(sim.get_int64_property({"b", "out"})->get_value() == 10);
+}
+
+TEST_CASE("test_simulation_variable_lookup")
+{
+    simulation sim(std::make_unique<fixed_step_algorithm>(0.1));
+    sim.add_slave(std::make_unique<affine_instance>("a", 2, 1));
+    sim.add_slave(std::make_unique<affine_instance>("b", 1, 0));
+
+    CHECK(sim.get_instance("b")->instanceName() == "b");
+    CHECK_FALSE(sim.get_instance("c"));
+    CHECK_THROWS(sim.add_slave(std::make_unique<affine_instance>("a", 1, 0)));
+
+    CHECK(sim.get_real_property({"a", "out"}) == sim.get_instance("a")->get_properties().get_real_property("out"));
+    CHECK_FALSE(sim.get_real_property({"a", "missing"}));
+    CHECK_FALSE(sim.get_int_property({"a", "out"}));
+
+    const auto in = sim.resolve({"a", "in"});
+    const auto out = sim.resolve({"a", "out"});
+    CHECK_THROWS(sim.resolve({"c", "in"}));
+    sim.init();
+
+    sim.set<double>(in, 3);
+    sim.step();
+    CHECK_THAT(sim.get<double>(out), Catch::Matchers::WithinRel(7.0));
+    CHECK_THROWS(sim.get<int>(out));
+    CHECK_THROWS(sim.get<double>(variable_handle(100)));
+}
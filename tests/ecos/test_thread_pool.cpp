@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ecos/util/thread_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace ecos;
+
+TEST_CASE("test_thread_pool")
+{
+    thread_pool pool(4);
+    REQUIRE(pool.num_threads() == 4);
+
+    SECTION("every task runs exactly once")
+    {
+        for (const size_t numTasks : {0, 1, 3, 4, 7, 100}) {
+            std::vector<std::atomic<int>> counts(numTasks);
+            for (int job = 0; job < 100; ++job) {
+                pool.parallel_for(numTasks, [&](size_t i) {
+                    ++counts[i];
+                });
+            }
+            for (const auto& count : counts) {
+                CHECK(count == 100);
+            }
+        }
+    }
+
+    SECTION("exceptions propagate to the caller")
+    {
+        CHECK_THROWS_AS(pool.parallel_for(10, [](size_t i) {
+            if (i == 7) throw std::runtime_error("task failed");
+        }),
+            std::runtime_error);
+
+        std::atomic<int> count{0};
+        pool.parallel_for(10, [&](size_t) { ++count; });
+        CHECK(count == 10);
+    }
+}
+
+TEST_CASE("test_thread_pool_partitioned")
+{
+    thread_pool pool(3);
+
+    const std::vector<size_t> offsets{0, 1, 1, 6};
+    std::vector<std::atomic<int>> counts(6);
+    std::vector<size_t> threads(6);
+    pool.parallel_for(offsets, [&](size_t i) {
+        ++counts[i];
+        threads[i] = thread_pool::current_thread_index();
+    });
+
+    for (size_t i = 0; i < counts.size(); ++i) {
+        CHECK(counts[i] == 1);
+        CHECK(threads[i] < pool.num_threads());
+    }
+
+    CHECK_THROWS(pool.parallel_for(std::vector<size_t>{0, 6}, [](size_t) { }));
+}
+
+TEST_CASE("test_thread_pool_single_thread")
+{
+    thread_pool pool(1, true);
+    REQUIRE(pool.num_threads() == 1);
+
+    int sum = 0;
+    pool.parallel_for(10, [&](size_t i) {
+        sum += static_cast<int>(i);
+    });
+    CHECK(sum == 45);
+}
@@ -3,6 +3,8 @@
 #include <util/temp_dir.hpp>
 #include <util/unzipper.hpp>
 
+#include <fstream>
+
 using namespace ecos;
 
 TEST_CASE("test_unzipper")
@@ -16,7 +18,7 @@ TEST_CASE("test_unzipper")
     {
         temp_dir tmp("ssp");
         sspPath = tmp.path();
-        REQUIRE(unzip(quarter_truck, tmp.path()));
+        REQUIRE_NOTHROW(unzip(quarter_truck, tmp.path()));
 
         CHECK(std::filesystem::exists(sspPath));
 
@@ -24,7 +26,49 @@ TEST_CASE("test_unzipper")
         CHECK(std::filesystem::exists(tmp.path() / "resources/chassis.fmu"));
         CHECK(std::filesystem::exists(tmp.path() / "resources/ground.fmu"));
         CHECK(std::filesystem::exists(tmp.path() / "resources/wheel.fmu"));
+
+        // nested archives extract just the same
+        REQUIRE_NOTHROW(unzip(tmp.path() / "resources/chassis.fmu", tmp.path() / "chassis"));
+        CHECK(std::filesystem::exists(tmp.path() / "chassis/modelDescription.xml"));
     }
 
     CHECK(!std::filesystem::exists(sspPath));
 }
+
+TEST_CASE("test_zip_archive")
+{
+    const std::string fmu = std::string(DATA_FOLDER) + "/fmus/3.0/ref/BouncingBall.fmu";
+    const zip_archive archive(fmu);
+
+    const auto entry = archive.find("modelDescription.xml");
+    REQUIRE(entry);
+
+    // single members are read without extracting anything
+    const auto xml = archive.read("modelDescription.xml");
+    CHECK(xml.size() == entry->size);
+    CHECK(xml.find("<fmiModelDescription") != std::string::npos);
+
+    try {
+        (void) archive.read("no_such_entry.xml");
+        FAIL("Expected a zip_error");
+    } catch (const zip_error& ex) {
+        CHECK(ex.code() == zip_errc::no_such_entry);
+    }
+
+    try {
+        zip_archive missing(std::string(DATA_FOLDER) + "/no_such.fmu");
+        FAIL("Expected a zip_error");
+    } catch (const zip_error& ex) {
+        CHECK(ex.code() == zip_errc::no_such_file);
+    }
+
+    temp_dir tmp("not_a_zip");
+    const auto notAZip = tmp.path() / "model.fmu";
+    std::ofstream(notAZip) << "<fmiModelDescription/>";
+    try {
+        zip_archive invalid(notAZip);
+        FAIL("Expected a zip_error");
+    } catch (const zip_error& ex) {
+        CHECK(ex.code() == zip_errc::invalid_archive);
+    }
+}
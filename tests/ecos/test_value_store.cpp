@@ -0,0 +1,35 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ecos/value_store.hpp>
+
+using namespace ecos;
+
+TEST_CASE("test_value_store")
+{
+    value_store store;
+
+    const auto s1 = store.allocate({2, 1, 0, 1});
+    const auto s2 = store.allocate({3, 0, 2, 0});
+
+    CHECK(store.reals().size() == 5);
+    CHECK(store.integers().size() == 1);
+    CHECK(store.booleans().size() == 2);
+    CHECK(store.strings().size() == 1);
+
+    CHECK(s1.realOffset == 0);
+    CHECK(s2.realOffset == 2);
+    CHECK(s2.integerOffset == 1);
+    CHECK(s2.booleanOffset == 0);
+
+    store.reals(s2)[0] = 10;
+    store.booleans(s2)[1] = true;
+    store.strings(s1)[0] = "hello";
+
+    CHECK(store.reals()[s2.realOffset] == 10);
+    CHECK(store.booleans()[s2.booleanOffset + 1] == 1);
+    CHECK(store.strings()[0] == "hello");
+    CHECK(store.integers(s2).empty());
+
+    store.clear();
+    CHECK(store.reals().empty());
+}
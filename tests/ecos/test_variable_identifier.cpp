@@ -3,6 +3,8 @@
 #include <ecos/variable_identifier.hpp>
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 using namespace ecos;
 
@@ -37,6 +39,23 @@ TEST_CASE("test_variable_identifier")
         CHECK_FALSE(b < a);
     }
 
+    SECTION("Interning")
+    {
+        variable_identifier a("instance1::variable1");
+        variable_identifier b(std::string("instance1"), std::string("variable1"));
+        variable_identifier c("variable1", "instance1");
+
+        CHECK(a.key() == b.key());
+        CHECK(std::hash<variable_identifier>{}(a) == std::hash<variable_identifier>{}(b));
+        CHECK(&a.instance_name() == &b.instance_name());
+        CHECK(&a.variable_name() == &c.instance_name());
+        CHECK_FALSE(a == c);
+
+        const auto [instanceName, variableName] = a;
+        CHECK(instanceName == "instance1");
+        CHECK(variableName == "variable1");
+    }
+
     SECTION("str()")
     {
         variable_identifier a("instance1", "variable1");
@@ -93,3 +112,18 @@ TEST_CASE("test_variable_identifier")
         CHECK(!a.matches("bus::length"));
     }
 }
+
+TEST_CASE("test_variable_identifier_many_names")
+{
+    // spans several of the chunks names are stored in, each larger than the previous one
+    constexpr int n = 20000;
+    std::vector<variable_identifier> ids;
+    ids.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        ids.emplace_back("many", "var" + std::to_string(i));
+    }
+    for (int i = 0; i < n; ++i) {
+        REQUIRE(ids[i].variable_name() == "var" + std::to_string(i));
+        REQUIRE(ids[i] == variable_identifier("many", "var" + std::to_string(i)));
+    }
+}
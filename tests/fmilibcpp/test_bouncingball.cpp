@@ -39,6 +39,14 @@ void test(fmilibcpp::fmu& fmu)
 
     CHECK(h == Catch::Approx(0.0235492));
 
+    // batched reads agree with single reads
+    const std::vector<fmilibcpp::value_ref> vrs{1, 3, 6};
+    std::vector<double> values(vrs.size());
+    REQUIRE(slave->get_real(vrs, values));
+    CHECK(values[0] == h);
+    CHECK(values[1] == slave->get_real(3));
+    CHECK(values[2] == Catch::Approx(0.7));
+
     REQUIRE(slave->terminate());
     slave->freeInstance();
 }
@@ -0,0 +1,346 @@
+#include "fmilibcpp/buffered_slave.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace
+{
+
+std::atomic<size_t> numAllocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++numAllocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+using namespace fmilibcpp;
+
+namespace
+{
+
+// Feeds its inputs through to its outputs when stepped, without allocating
+class passthrough_slave : public slave
+{
+
+public:
+    passthrough_slave()
+        : slave("passthrough")
+    {
+        md_.canGetAndSetState = false;
+        // value references need not be compact
+        md_.add_variable({10, "realIn", "", "Input", "Continuous", real_attributes{}});
+        md_.add_variable({20, "realOut", "", "Output", "Continuous", real_attributes{}});
+        md_.add_variable({1000000, "intIn", "", "Input", "Discrete", integer_attributes{}});
+        md_.add_variable({2000000, "intOut", "", "Output", "Discrete", integer_attributes{}});
+        md_.add_variable({0, "boolIn", "", "Input", "Discrete", boolean_attributes{}});
+        md_.add_variable({1, "boolOut", "", "Output", "Discrete", boolean_attributes{}});
+        md_.add_variable({0, "stringIn", "", "Input", "Discrete", string_attributes{}});
+        md_.add_variable({1, "stringOut", "", "Output", "Discrete", string_attributes{}});
+        md_.add_variable({30, "realConstant", "", "Output", "Constant", real_attributes{}});
+        md_.add_variable({0, "int64In", "", "Input", "Discrete", int64_attributes{}});
+        md_.add_variable({1, "int64Out", "", "Output", "Discrete", int64_attributes{}});
+        md_.add_variable({0, "uint64In", "", "Input", "Discrete", uint64_attributes{}});
+        md_.add_variable({1, "uint64Out", "", "Output", "Discrete", uint64_attributes{}});
+        md_.add_variable({0, "float32In", "", "Input", "Continuous", float32_attributes{}});
+        md_.add_variable({1, "float32Out", "", "Output", "Continuous", float32_attributes{}});
+    }
+
+    [[nodiscard]] const model_description& get_model_description() const override { return md_; }
+    void set_debug_logging(bool flag) override { }
+    bool enter_initialization_mode(double, double, double) override { return true; }
+    bool exit_initialization_mode() override { return true; }
+    bool terminate() override { return true; }
+    bool reset() override { return true; }
+    void freeInstance() override { }
+
+    bool step(double currentTime, double stepSize) override
+    {
+        realOut_ = realIn_;
+        intOut_ = intIn_;
+        boolOut_ = boolIn_;
+        stringOut_ = stringIn_;
+        int64Out_ = int64In_;
+        uint64Out_ = uint64In_;
+        float32Out_ = float32In_;
+        return true;
+    }
+
+    // only the span based batch calls are made by buffered_slave
+    bool get_integer(const std::vector<value_ref>&, std::vector<int32_t>&) override { return false; }
+    bool get_real(const std::vector<value_ref>&, std::vector<double>&) override { return false; }
+    bool get_string(const std::vector<value_ref>&, std::vector<std::string>&) override { return false; }
+    bool get_boolean(const std::vector<value_ref>&, std::vector<bool>&) override { return false; }
+    bool set_integer(const std::vector<value_ref>&, const std::vector<int32_t>&) override { return false; }
+    bool set_real(const std::vector<value_ref>&, const std::vector<double>&) override { return false; }
+    bool set_string(const std::vector<value_ref>&, const std::vector<std::string>&) override { return false; }
+    bool set_boolean(const std::vector<value_ref>&, const std::vector<bool>&) override { return false; }
+
+    bool get_integer(std::span<const value_ref> vrs, std::span<int32_t> values) override
+    {
+        ++integerGets;
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 1000000 ? intIn_ : intOut_;
+        return true;
+    }
+
+    bool get_real(std::span<const value_ref> vrs, std::span<double> values) override
+    {
+        ++realGets;
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 10 ? realIn_ : vrs[i] == 30 ? 42 : realOut_;
+        return true;
+    }
+
+    bool get_string(std::span<const value_ref> vrs, std::span<const char*> values) override
+    {
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 0 ? stringIn_.c_str() : stringOut_.c_str();
+        return true;
+    }
+
+    bool get_boolean(std::span<const value_ref> vrs, std::span<uint8_t> values) override
+    {
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 0 ? boolIn_ : boolOut_;
+        return true;
+    }
+
+    bool set_integer(std::span<const value_ref> vrs, std::span<const int32_t> values) override
+    {
+        intIn_ = values.front();
+        return true;
+    }
+
+    bool set_real(std::span<const value_ref> vrs, std::span<const double> values) override
+    {
+        realIn_ = values.front();
+        return true;
+    }
+
+    bool set_string(std::span<const value_ref> vrs, std::span<const char* const> values) override
+    {
+        stringIn_ = values.front();
+        return true;
+    }
+
+    bool set_boolean(std::span<const value_ref> vrs, std::span<const uint8_t> values) override
+    {
+        boolIn_ = values.front() != 0;
+        return true;
+    }
+
+    bool get_int64(std::span<const value_ref> vrs, std::span<int64_t> values) override
+    {
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 0 ? int64In_ : int64Out_;
+        return true;
+    }
+
+    bool get_uint64(std::span<const value_ref> vrs, std::span<uint64_t> values) override
+    {
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 0 ? uint64In_ : uint64Out_;
+        return true;
+    }
+
+    bool get_float32(std::span<const value_ref> vrs, std::span<float> values) override
+    {
+        for (size_t i = 0; i < vrs.size(); ++i) values[i] = vrs[i] == 0 ? float32In_ : float32Out_;
+        return true;
+    }
+
+    bool set_int64(std::span<const value_ref> vrs, std::span<const int64_t> values) override
+    {
+        int64In_ = values.front();
+        return true;
+    }
+
+    bool set_uint64(std::span<const value_ref> vrs, std::span<const uint64_t> values) override
+    {
+        uint64In_ = values.front();
+        return true;
+    }
+
+    bool set_float32(std::span<const value_ref> vrs, std::span<const float> values) override
+    {
+        float32In_ = values.front();
+        return true;
+    }
+
+    size_t integerGets{0};
+    size_t realGets{0};
+
+private:
+    model_description md_;
+    double realIn_{}, realOut_{};
+    int intIn_{}, intOut_{};
+    bool boolIn_{}, boolOut_{};
+    std::string stringIn_, stringOut_;
+    int64_t int64In_{}, int64Out_{};
+    uint64_t uint64In_{}, uint64Out_{};
+    float float32In_{}, float32Out_{};
+};
+
+} // namespace
+
+TEST_CASE("test_buffered_slave")
+{
+    buffered_slave slave(std::make_unique<passthrough_slave>());
+    REQUIRE(slave.enter_initialization_mode());
+    REQUIRE(slave.exit_initialization_mode());
+
+    const std::vector<value_ref> realOut{20};
+    const std::vector<value_ref> intOut{2000000};
+    const std::vector<value_ref> boolOut{1};
+    const std::vector<value_ref> stringOut{1};
+    std::vector<double> realValues(1);
+    std::vector<int> intValues(1);
+    std::vector<bool> boolValues(1);
+    std::vector<std::string> stringValues(1);
+
+    const size_t realIn = slave.real_slot(10);
+    const size_t intIn = slave.integer_slot(1000000);
+    const size_t boolIn = slave.boolean_slot(0);
+    const size_t stringIn = slave.string_slot(0);
+
+    const auto step = [&](int i) {
+        slave.set_real_at(realIn, i);
+        slave.set_integer_at(intIn, i);
+        slave.set_boolean_at(boolIn, i % 2 == 0);
+        slave.set_string_at(stringIn, i % 2 == 0 ? "even" : "odd");
+        slave.transferCachedSets();
+        slave.step(i, 1);
+        slave.receiveCachedGets();
+
+        slave.get_real(realOut, realValues);
+        slave.get_integer(intOut, intValues);
+        slave.get_boolean(boolOut, boolValues);
+        slave.get_string(stringOut, stringValues);
+    };
+
+    // fetching starts on first read
+    for (int i = 0; i < 2; ++i) {
+        step(i);
+    }
+    CHECK(realValues[0] == 1);
+    CHECK(intValues[0] == 1);
+    CHECK(boolValues[0] == false);
+    CHECK(stringValues[0] == "odd");
+
+    const size_t before = numAllocations;
+    for (int i = 2; i < 100; ++i) {
+        step(i);
+    }
+    const size_t allocations = numAllocations - before;
+
+    CHECK(allocations == 0);
+    CHECK(realValues[0] == 99);
+    CHECK(intValues[0] == 99);
+    CHECK(boolValues[0] == false);
+    CHECK(stringValues[0] == "odd");
+
+    // unchanged values are not set again
+    const auto setCalls = slave.get_set_statistics().callsIssued;
+    slave.set_real_at(realIn, 99);
+    slave.transferCachedSets();
+    CHECK(slave.get_set_statistics().callsIssued == setCalls);
+
+    CHECK_THROWS(slave.real_slot(11));
+    CHECK_THROWS(slave.integer_slot(10));
+}
+
+TEST_CASE("test_buffered_slave_fetching")
+{
+    auto instance = std::make_unique<passthrough_slave>();
+    const auto& counts = *instance;
+    buffered_slave slave(std::move(instance));
+    REQUIRE(slave.enter_initialization_mode());
+    REQUIRE(slave.exit_initialization_mode());
+
+    const size_t realIn = slave.real_slot(10);
+    const size_t intIn = slave.integer_slot(1000000);
+    const size_t realOut = slave.real_slot(20);
+    const size_t intOut = slave.integer_slot(2000000);
+    const size_t realConstant = slave.real_slot(30);
+
+    // connected outputs are subscribed to, and fetched with every step
+    slave.subscribe_real(realOut);
+
+    const std::vector<value_ref> constantVr{30};
+    std::vector<double> constantValues(1);
+
+    for (int i = 1; i <= 10; ++i) {
+        slave.set_real_at(realIn, i);
+        slave.set_integer_at(intIn, 10 * i);
+        slave.transferCachedSets();
+        slave.step(i, 1);
+        slave.receiveCachedGets();
+
+        const size_t realGets = counts.realGets;
+        const size_t integerGets = counts.integerGets;
+        CHECK(slave.real_values()[realOut] == i);
+
+        // others are only fetched when read
+        if (i % 5 == 0) {
+            slave.refresh_integer(intOut);
+            CHECK(slave.integer_values()[intOut] == 10 * i);
+            CHECK(counts.integerGets == integerGets + 1);
+        }
+        CHECK(counts.integerGets == integerGets + (i % 5 == 0 ? 1 : 0));
+
+        // constants are fetched once
+        slave.get_real(constantVr, constantValues);
+        CHECK(constantValues[0] == 42);
+        CHECK(counts.realGets == realGets + (i == 1 ? 1 : 0));
+    }
+    CHECK(counts.integerGets == 2);
+    CHECK(counts.realGets == 12);
+    CHECK(slave.real_fetched_at()[realConstant] > *slave.generation());
+}
+
+TEST_CASE("test_buffered_slave_64bit")
+{
+    buffered_slave slave(std::make_unique<passthrough_slave>());
+    REQUIRE(slave.enter_initialization_mode());
+    REQUIRE(slave.exit_initialization_mode());
+
+    const size_t int64In = slave.int64_slot(0);
+    const size_t uint64In = slave.uint64_slot(0);
+    const size_t float32In = slave.float32_slot(0);
+    const size_t int64Out = slave.int64_slot(1);
+    slave.subscribe_int64(int64Out);
+
+    // values beyond the range of 32-bit integers and doubles are kept exact
+    const int64_t large = -(int64_t{1} << 62) - 1;
+    const uint64_t huge = std::numeric_limits<uint64_t>::max() - 1;
+    slave.set_int64_at(int64In, large);
+    slave.set_uint64_at(uint64In, huge);
+    slave.set_float32_at(float32In, 0.1f);
+    slave.transferCachedSets();
+    slave.step(0, 1);
+    slave.receiveCachedGets();
+
+    CHECK(slave.int64_values()[int64Out] == large);
+
+    const std::vector<value_ref> out{1};
+    std::vector<uint64_t> uint64Values(1);
+    std::vector<float> float32Values(1);
+    slave.get_uint64(out, uint64Values);
+    slave.get_float32(out, float32Values);
+    CHECK(uint64Values[0] == huge);
+    CHECK(float32Values[0] == 0.1f);
+
+    CHECK_THROWS(slave.int64_slot(2));
+    CHECK_THROWS(slave.float32_slot(2));
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "fmilibcpp/fmi3/fmi3_batches.hpp"
+
+#include <map>
+#include <vector>
+
+using namespace fmilibcpp;
+
+namespace
+{
+
+// Stands in for the fmi4c calls of an FMU, recording the calls made per data type
+struct stub_calls
+{
+    std::map<value_ref, int64_t> values;
+    std::map<size_t, int> numCalls; // by size of the native type
+
+    template<class T>
+    bool get(const value_ref* vr, size_t n, T* out)
+    {
+        ++numCalls[sizeof(T)];
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<T>(values.at(vr[i]));
+        }
+        return true;
+    }
+
+    template<class T>
+    bool set(const value_ref* vr, size_t n, const T* in)
+    {
+        ++numCalls[sizeof(T)];
+        for (size_t i = 0; i < n; ++i) {
+            values.at(vr[i]) = static_cast<int64_t>(in[i]);
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+TEST_CASE("test_fmi3_batches")
+{
+    fmi3_batches batches("instance", {
+                                         {0, fmi3_type::int8},
+                                         {1, fmi3_type::int16},
+                                         {2, fmi3_type::int32},
+                                         {3, fmi3_type::uint8},
+                                         {4, fmi3_type::uint16},
+                                         {5, fmi3_type::uint32},
+                                         {6, fmi3_type::int64},
+                                         {7, fmi3_type::int32},
+                                         {8, fmi3_type::float64},
+                                     });
+
+    stub_calls calls;
+    calls.values = {{0, -100}, {1, -30000}, {2, -2000000000}, {3, 200}, {4, 60000}, {5, 4000000000}, {6, -5000000000}, {7, 7}, {8, 0}};
+
+    // mixed data types, interleaved
+    const std::vector<value_ref> vr{4, 2, 0, 7, 3, 1};
+    std::vector<int32_t> values(vr.size());
+    REQUIRE(batches.get(calls, std::span<const value_ref>(vr), std::span(values)));
+    CHECK(values == std::vector<int32_t>{60000, -2000000000, -100, 7, 200, -30000});
+    // one call per data type, Int8 and UInt8 share a width
+    CHECK(calls.numCalls == std::map<size_t, int>{{1, 2}, {2, 2}, {4, 1}});
+
+    // the grouping is reused for the same value references
+    REQUIRE(batches.get(calls, std::span<const value_ref>(vr), std::span(values)));
+    CHECK(batches.num_cached() == 1);
+
+    const std::vector<int32_t> newValues{1, 2, 3, 4, 5, 6};
+    REQUIRE(batches.set(calls, std::span<const value_ref>(vr), std::span<const int32_t>(newValues)));
+    CHECK(batches.num_cached() == 1);
+    CHECK(calls.values.at(4) == 1);
+    CHECK(calls.values.at(2) == 2);
+    CHECK(calls.values.at(0) == 3);
+    CHECK(calls.values.at(7) == 4);
+    CHECK(calls.values.at(3) == 5);
+    CHECK(calls.values.at(1) == 6);
+
+    // UInt32 does not fit int32_t, it is accessed along with Int64
+    const std::vector<value_ref> wide{6, 5};
+    std::vector<int64_t> wideValues(wide.size());
+    REQUIRE(batches.get(calls, std::span<const value_ref>(wide), std::span(wideValues)));
+    CHECK(wideValues == std::vector<int64_t>{-5000000000, 4000000000});
+    CHECK(batches.num_cached() == 2);
+
+    std::vector<int32_t> narrow(1);
+    CHECK_FALSE(batches.get(calls, std::span<const value_ref>(std::vector<value_ref>{5}), std::span(narrow)));
+
+    // unknown, or of another type
+    std::vector<double> reals(2);
+    CHECK_FALSE(batches.get(calls, std::span<const value_ref>(std::vector<value_ref>{8, 2}), std::span(reals)));
+    CHECK_FALSE(batches.get(calls, std::span<const value_ref>(std::vector<value_ref>{8, 100}), std::span(reals)));
+
+    // a batch of a single data type is passed through
+    calls.numCalls.clear();
+    std::vector<int32_t> int32s(2);
+    REQUIRE(batches.get(calls, std::span<const value_ref>(std::vector<value_ref>{7, 2}), std::span(int32s)));
+    CHECK(int32s == std::vector<int32_t>{4, 2});
+    CHECK(calls.numCalls == std::map<size_t, int>{{4, 1}});
+}
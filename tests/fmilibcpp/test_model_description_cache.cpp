@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "fmilibcpp/model_description_cache.hpp"
+#include "util/temp_dir.hpp"
+
+#include <fstream>
+
+using namespace fmilibcpp;
+
+namespace
+{
+
+model_description make_model_description()
+{
+    model_description md;
+    md.guid = "{guid}";
+    md.modelName = "model";
+    md.modelIdentifier = "identifier";
+    md.fmiVersion = "3.0";
+    md.description = "description";
+    md.canGetAndSetState = true;
+    md.defaultExperiment.stopTime = 10;
+    md.defaultExperiment.stepSize = 0.1;
+
+    md.add_variable({0, "integer", "an integer", "Input", "Discrete", integer_attributes{-1}});
+    md.add_variable({1, "real", "", "Output", "Continuous", real_attributes{}});
+    md.add_variable({2, "string", "", "Parameter", "Fixed", string_attributes{"start"}});
+    md.add_variable({3, "boolean", "", std::nullopt, std::nullopt, boolean_attributes{true}});
+    md.add_variable({4, "binary", "", "Local", "Discrete", binary_attributes{}});
+    md.add_variable({5, "int64", "", "Input", "Discrete", int64_attributes{INT64_MIN}});
+    md.add_variable({6, "uint64", "", "Input", "Discrete", uint64_attributes{UINT64_MAX}});
+    md.add_variable({7, "float32", "", "Input", "Continuous", float32_attributes{0.5f}});
+    return md;
+}
+
+} // namespace
+
+TEST_CASE("test_model_description_cache")
+{
+    ecos::temp_dir tmp("md_cache");
+    const auto file = tmp.path() / "model.md";
+
+    CHECK(!load_model_description(file, "fingerprint"));
+
+    const auto md = make_model_description();
+    save_model_description(md, file, "fingerprint");
+
+    const auto loaded = load_model_description(file, "fingerprint");
+    REQUIRE(loaded);
+    CHECK(loaded->guid == md.guid);
+    CHECK(loaded->modelName == md.modelName);
+    CHECK(loaded->modelIdentifier == md.modelIdentifier);
+    CHECK(loaded->description == md.description);
+    CHECK(loaded->canGetAndSetState);
+    CHECK(loaded->defaultExperiment.stopTime == 10);
+    CHECK(loaded->defaultExperiment.stepSize == 0.1);
+
+    REQUIRE(loaded->variables().size() == md.variables().size());
+    for (size_t i = 0; i < md.variables().size(); ++i) {
+        const auto& expected = md.variables()[i];
+        const auto& actual = loaded->variables()[i];
+        CHECK(actual.vr == expected.vr);
+        CHECK(actual.name == expected.name);
+        CHECK(actual.description == expected.description);
+        CHECK(actual.causality == expected.causality);
+        CHECK(actual.variability == expected.variability);
+        CHECK(actual.typeAttributes.index() == expected.typeAttributes.index());
+    }
+    CHECK(std::get<integer_attributes>(loaded->variables()[0].typeAttributes).start == -1);
+    CHECK(!std::get<real_attributes>(loaded->variables()[1].typeAttributes).start);
+    CHECK(std::get<string_attributes>(loaded->variables()[2].typeAttributes).start == "start");
+    CHECK(std::get<boolean_attributes>(loaded->variables()[3].typeAttributes).start == true);
+    CHECK(std::get<int64_attributes>(loaded->variables()[5].typeAttributes).start == INT64_MIN);
+    CHECK(std::get<uint64_attributes>(loaded->variables()[6].typeAttributes).start == UINT64_MAX);
+    CHECK(std::get<float32_attributes>(loaded->variables()[7].typeAttributes).start == 0.5f);
+
+    // written for another version of the FMU
+    CHECK(!load_model_description(file, "other fingerprint"));
+
+    // truncated, e.g. by a full disk
+    const auto size = std::filesystem::file_size(file);
+    for (const auto truncated : {size - 1, size / 2, uintmax_t{20}, uintmax_t{0}}) {
+        const auto copy = tmp.path() / "truncated.md";
+        std::filesystem::copy_file(file, copy, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::resize_file(copy, truncated);
+        CHECK(!load_model_description(copy, "fingerprint"));
+    }
+
+    // damaged
+    {
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-8, std::ios::end);
+        f.put('x');
+    }
+    CHECK(!load_model_description(file, "fingerprint"));
+}
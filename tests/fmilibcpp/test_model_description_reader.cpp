@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "fmilibcpp/fmu.hpp"
+
+using namespace fmilibcpp;
+
+namespace
+{
+
+// reading straight from the archive agrees with loading the FMU
+void compare_with_loaded(const std::string& fmuPath, const model_description& md)
+{
+    const auto fmu = loadFmu(fmuPath);
+    REQUIRE(fmu);
+    const auto& loaded = fmu->get_model_description();
+
+    CHECK(md.modelName == loaded.modelName);
+    CHECK(md.modelIdentifier == loaded.modelIdentifier);
+    CHECK(md.canGetAndSetState == loaded.canGetAndSetState);
+
+    REQUIRE(md.variables().size() == loaded.variables().size());
+    for (size_t i = 0; i < md.variables().size(); ++i) {
+        const auto& v = md.variables()[i];
+        const auto& l = loaded.variables()[i];
+        CHECK(v.name == l.name);
+        CHECK(v.vr == l.vr);
+        CHECK(type_name(v.typeAttributes) == type_name(l.typeAttributes));
+        CHECK(v.causality == l.causality);
+    }
+}
+
+} // namespace
+
+TEST_CASE("test_model_description_reader_fmi1")
+{
+    const std::string fmuPath = std::string(DATA_FOLDER) + "/fmus/1.0/identity.fmu";
+    const auto md = read_model_description(fmuPath);
+
+    CHECK(md.fmiVersion == "1.0");
+    CHECK(md.modelName == "no.viproma.demo.identity");
+    CHECK(md.modelIdentifier == "identity");
+    CHECK(md.guid == "ae713a03-634c-5da4-802e-9ea653e11f42");
+    CHECK(md.author == "Lars Tandle Kyllingstad");
+    CHECK(!md.canGetAndSetState);
+
+    REQUIRE(md.variables().size() == 8);
+    const auto realIn = md.get_by_name("realIn");
+    REQUIRE(realIn);
+    CHECK(realIn->is_real());
+    CHECK(realIn->causality == "Input");
+    CHECK(realIn->variability == "Discrete");
+    CHECK(std::get<real_attributes>(realIn->typeAttributes).start == 0.0);
+
+    const auto booleanIn = md.get_by_name("booleanIn");
+    REQUIRE(booleanIn);
+    CHECK(std::get<boolean_attributes>(booleanIn->typeAttributes).start == false);
+
+    const auto stringOut = md.get_by_name("stringOut");
+    REQUIRE(stringOut);
+    CHECK(stringOut->is_string());
+    CHECK(stringOut->causality == "Output");
+    CHECK(!std::get<string_attributes>(stringOut->typeAttributes).start);
+
+    // outputs are aliases of the inputs, lookups by value reference yield the first declared
+    CHECK(md.get_by_vr<double>(0) == realIn);
+    CHECK(md.get_by_vr<std::string>(0)->name == "stringIn");
+    const auto aliases = md.get_aliases(*stringOut);
+    REQUIRE(aliases.size() == 2);
+    CHECK(aliases[0]->name == "stringIn");
+    CHECK(aliases[1] == stringOut);
+    CHECK(!md.get_by_vr<int64_t>(0));
+
+    compare_with_loaded(fmuPath, md);
+}
+
+TEST_CASE("test_model_description_reader_fmi2")
+{
+    const std::string fmuPath = std::string(DATA_FOLDER) + "/fmus/2.0/20sim/ControlledTemperature.fmu";
+    const auto md = read_model_description(fmuPath);
+
+    CHECK(md.fmiVersion == "2.0");
+    CHECK(md.modelName == "ControlledTemperature");
+    CHECK(md.modelIdentifier == "ControlledTemperature");
+    CHECK(md.guid == "{06c2700b-b39c-4895-9151-304ddde28443}");
+    CHECK(md.defaultExperiment.stopTime == 20.0);
+    CHECK(md.defaultExperiment.stepSize == 1e-4);
+
+    const auto capacity = md.get_by_name("HeatCapacity1.C");
+    REQUIRE(capacity);
+    CHECK(capacity->vr == 0);
+    CHECK(capacity->description == "thermal capacity");
+    CHECK(capacity->causality == "Parameter");
+    CHECK(capacity->variability == "Tunable");
+    CHECK(std::get<real_attributes>(capacity->typeAttributes).start == 0.1);
+
+    compare_with_loaded(fmuPath, md);
+}
+
+TEST_CASE("test_model_description_reader_fmi3")
+{
+    const std::string fmuPath = std::string(DATA_FOLDER) + "/fmus/3.0/ref/BouncingBall.fmu";
+    const auto md = read_model_description(fmuPath);
+
+    CHECK(md.fmiVersion == "3.0");
+    CHECK(md.modelName == "BouncingBall");
+    CHECK(md.modelIdentifier == "BouncingBall");
+    CHECK(md.guid == "{1AE5E10D-9521-4DE3-80B9-D0EAAA7D5AF1}");
+    CHECK(md.canGetAndSetState);
+    CHECK(md.defaultExperiment.stopTime == 3.0);
+
+    REQUIRE(md.variables().size() == 8);
+    const auto g = md.get_by_vr<double>(5);
+    REQUIRE(g);
+    CHECK(g->name == "g");
+    CHECK(g->causality == "Parameter");
+    CHECK(g->variability == "Fixed");
+    CHECK(std::get<real_attributes>(g->typeAttributes).start == -9.81);
+
+    // causality defaults to local
+    const auto vMin = md.get_by_name("v_min");
+    REQUIRE(vMin);
+    CHECK(vMin->causality == "Local");
+    CHECK(vMin->variability == "Constant");
+
+    compare_with_loaded(fmuPath, md);
+}
+
+TEST_CASE("test_model_description_reader_added")
+{
+    auto md = read_model_description(std::string(DATA_FOLDER) + "/fmus/1.0/identity.fmu");
+    const auto realIn = md.get_by_name("realIn");
+    REQUIRE(realIn);
+    CHECK(!md.get_by_name("extra"));
+    CHECK(!md.get_by_vr<double>(42));
+
+    // variables are indexed as they are added
+    md.add_variable({42, "extra", "", "Output", "Discrete", real_attributes{}});
+    md.add_variable({0, "realAlias", "", "Output", "Discrete", real_attributes{}});
+
+    const auto extra = md.get_by_name("extra");
+    REQUIRE(extra);
+    CHECK(md.get_by_vr<double>(42) == extra);
+    const auto aliases = md.get_aliases(*md.get_by_vr<double>(0));
+    REQUIRE(aliases.size() == 3);
+    CHECK(aliases[0]->name == "realIn");
+    CHECK(aliases[1]->name == "realOut");
+    CHECK(aliases[2]->name == "realAlias");
+}
+
+TEST_CASE("test_model_description_reader_missing")
+{
+    CHECK_THROWS(read_model_description(std::string(DATA_FOLDER) + "/fmus/no_such.fmu"));
+}
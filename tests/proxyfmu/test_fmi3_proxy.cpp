@@ -0,0 +1,43 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "proxyfmu/proxy_fmu.hpp"
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("proxy_test_fmi3_types")
+{
+    std::string fmuPath = std::string(DATA_FOLDER) + "/fmus/3.0/ref/BouncingBall.fmu";
+    auto fmu = ecos::proxy::proxy_fmu(fmuPath);
+    const auto& md = fmu.get_model_description();
+    CHECK(md.fmiVersion == "3.0");
+
+    auto slave = fmu.new_instance("instance");
+    REQUIRE(slave);
+    REQUIRE(slave->enter_initialization_mode());
+    REQUIRE(slave->exit_initialization_mode());
+
+    // the FMI 3 types are carried over the proxy protocol, rather than throwing "not implemented"
+    std::vector<fmilibcpp::value_ref> none;
+    std::vector<int64_t> int64s;
+    std::vector<uint64_t> uint64s;
+    std::vector<float> float32s;
+    CHECK(slave->get_int64(none, int64s));
+    CHECK(slave->get_uint64(none, uint64s));
+    CHECK(slave->get_float32(none, float32s));
+    CHECK(slave->set_int64(none, std::vector<int64_t>{}));
+    CHECK(slave->set_uint64(none, std::vector<uint64_t>{}));
+    CHECK(slave->set_float32(none, std::vector<float>{}));
+
+    std::vector<fmilibcpp::value_ref> vr{md.get_by_name("g")->vr};
+    std::vector<double> g(1);
+    REQUIRE(slave->get_real(vr, g));
+    CHECK(g[0] == -9.81);
+
+    // g is a Float64, the status of the FMU is reported back for a mismatching type
+    float32s.resize(1);
+    CHECK_FALSE(slave->get_float32(vr, float32s));
+
+    REQUIRE(slave->terminate());
+    slave->freeInstance();
+}
@@ -32,7 +32,7 @@ void test(fmu* damper, fmu* mass, fmu* spring)
         const auto& name = names[i++];
         auto instance = fmu->new_instance(name);
         REQUIRE(instance);
-        const auto& mv = fmu->get_model_description().modelVariables;
+        const auto& mv = fmu->get_model_description().variables();
 
         if (name == "spring") {
             std::vector<unsigned int> vr = {
@@ -55,24 +55,24 @@ void test(fmu* damper, fmu* mass, fmu* spring)
         slaves[name] = std::move(instance);
     }
 
-    unsigned int spring_for_xx = getRealValueRef(slaves["spring"]->get_model_description().modelVariables, "for_xx");
-    unsigned int spring_for_yx = getRealValueRef(slaves["spring"]->get_model_description().modelVariables, "for_yx");
-    unsigned int spring_dis_xx = getRealValueRef(slaves["spring"]->get_model_description().modelVariables, "dis_xx");
-    unsigned int spring_dis_yx = getRealValueRef(slaves["spring"]->get_model_description().modelVariables, "dis_yx");
-
-    unsigned int mass_in_f_u = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "in_f_u");
-    unsigned int mass_in_f_w = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "in_f_w");
-    unsigned int mass_out_f_u = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "out_f_u");
-    unsigned int mass_out_f_w = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "out_f_w");
-    unsigned int mass_in_l_u = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "in_l_u");
-    unsigned int mass_in_l_w = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "in_l_w");
-    unsigned int mass_out_l_u = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "out_l_u");
-    unsigned int mass_out_l_w = getRealValueRef(slaves["mass"]->get_model_description().modelVariables, "out_l_w");
-
-    unsigned int damper_df_0 = getRealValueRef(slaves["damper"]->get_model_description().modelVariables, "df_0");
-    unsigned int damper_df_1 = getRealValueRef(slaves["damper"]->get_model_description().modelVariables, "df_1");
-    unsigned int damper_lv_0 = getRealValueRef(slaves["damper"]->get_model_description().modelVariables, "lv_0");
-    unsigned int damper_lv_1 = getRealValueRef(slaves["damper"]->get_model_description().modelVariables, "lv_1");
+    unsigned int spring_for_xx = getRealValueRef(slaves["spring"]->get_model_description().variables(), "for_xx");
+    unsigned int spring_for_yx = getRealValueRef(slaves["spring"]->get_model_description().variables(), "for_yx");
+    unsigned int spring_dis_xx = getRealValueRef(slaves["spring"]->get_model_description().variables(), "dis_xx");
+    unsigned int spring_dis_yx = getRealValueRef(slaves["spring"]->get_model_description().variables(), "dis_yx");
+
+    unsigned int mass_in_f_u = getRealValueRef(slaves["mass"]->get_model_description().variables(), "in_f_u");
+    unsigned int mass_in_f_w = getRealValueRef(slaves["mass"]->get_model_description().variables(), "in_f_w");
+    unsigned int mass_out_f_u = getRealValueRef(slaves["mass"]->get_model_description().variables(), "out_f_u");
+    unsigned int mass_out_f_w = getRealValueRef(slaves["mass"]->get_model_description().variables(), "out_f_w");
+    unsigned int mass_in_l_u = getRealValueRef(slaves["mass"]->get_model_description().variables(), "in_l_u");
+    unsigned int mass_in_l_w = getRealValueRef(slaves["mass"]->get_model_description().variables(), "in_l_w");
+    unsigned int mass_out_l_u = getRealValueRef(slaves["mass"]->get_model_description().variables(), "out_l_u");
+    unsigned int mass_out_l_w = getRealValueRef(slaves["mass"]->get_model_description().variables(), "out_l_w");
+
+    unsigned int damper_df_0 = getRealValueRef(slaves["damper"]->get_model_description().variables(), "df_0");
+    unsigned int damper_df_1 = getRealValueRef(slaves["damper"]->get_model_description().variables(), "df_1");
+    unsigned int damper_lv_0 = getRealValueRef(slaves["damper"]->get_model_description().variables(), "lv_0");
+    unsigned int damper_lv_1 = getRealValueRef(slaves["damper"]->get_model_description().variables(), "lv_1");
 
     std::vector<double> spring_out(2);
     std::vector<double> damper_out(2);
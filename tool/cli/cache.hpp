@@ -0,0 +1,65 @@
+#ifndef LIBECOS_CACHE_HPP
+#define LIBECOS_CACHE_HPP
+
+#include "util/fmu_cache.hpp"
+
+#include "ecos/logger/logger.hpp"
+
+#include <cli11/CLI11.h>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+namespace ecos
+{
+
+inline void create_cache_options(CLI::App& app)
+{
+    auto cache = app.add_subcommand("cache", "Inspect and prune the FMU extraction cache (enabled by ECOS_FMU_CACHE).");
+
+    cache->add_option("--dir", "Location of the cache, defaults to ECOS_FMU_CACHE.");
+    cache->add_option("--prune", "Evict the least recently used entries until at most this many MB remain.");
+    cache->add_flag("--clear", "Evict every entry.");
+}
+
+inline void parse_cache_options(const CLI::App& app)
+{
+    std::optional<fmu_cache> cache;
+    if (app.count("--dir")) {
+        cache = fmu_cache(app["--dir"]->as<std::string>());
+    } else {
+        cache = fmu_cache::from_environment();
+    }
+    if (!cache) {
+        throw std::runtime_error("No cache directory given, and ECOS_FMU_CACHE is not set");
+    }
+
+    if (app.count("--clear")) {
+        const auto numEvicted = cache->clear();
+        log::info("Evicted {} entries from '{}'", numEvicted, cache->dir().string());
+    } else if (app.count("--prune")) {
+        const auto maxSize = app["--prune"]->as<uint64_t>() * 1024 * 1024;
+        const auto numEvicted = cache->prune(maxSize);
+        log::info("Evicted {} entries from '{}'", numEvicted, cache->dir().string());
+    }
+
+    auto entries = cache->list();
+    std::ranges::sort(entries, [](const auto& a, const auto& b) {
+        return a.lastUsed > b.lastUsed;
+    });
+
+    uint64_t total = 0;
+    for (const auto& e : entries) {
+        const auto lastUsed = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() +
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(e.lastUsed - std::filesystem::file_time_type::clock::now()));
+        std::cout << e.key << "  " << std::setw(10) << std::fixed << std::setprecision(1) << e.size / (1024.0 * 1024.0)
+                  << " MB  " << std::put_time(std::localtime(&lastUsed), "%F %T") << "  " << e.source << "\n";
+        total += e.size;
+    }
+    std::cout << entries.size() << " entries, " << std::fixed << std::setprecision(1) << total / (1024.0 * 1024.0)
+              << " MB in " << cache->dir().string() << " (max " << cache->max_size() / (1024 * 1024) << " MB)" << std::endl;
+}
+
+} // namespace ecos
+
+#endif // LIBECOS_CACHE_HPP
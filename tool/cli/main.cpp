@@ -1,4 +1,5 @@
 
+#include "cache.hpp"
 #include "compile.hpp"
 #include "simulate.hpp"
 
@@ -33,6 +34,7 @@ void create_options(CLI::App& app)
 
     create_simulate_options(app);
     create_compile_options(app);
+    create_cache_options(app);
 }
 
 } // namespace
@@ -62,6 +64,11 @@ int main(int argc, char** argv)
                 parse_compile_options(*sub);
             }
         }
+        if (const auto* sub = app.get_subcommand("cache")) {
+            if (sub->parsed()) {
+                parse_cache_options(*sub);
+            }
+        }
 
 
     } catch (std::exception& e) {
@@ -36,11 +36,13 @@ inline void create_simulate_options(CLI::App& app)
     simulate->add_flag("--noCsv", "Disable CSV logging.")->configurable(false);
     simulate->add_flag("--noParallel", "Run single-threaded.")->configurable(false);
     simulate->add_flag("--debugLogging", "Enable debug logging.")->configurable(false);
+    simulate->add_flag("--pinThreads", "Pin worker threads to individual cores.")->configurable(false);
 
     simulate->add_option("--path", "Location of the fmu/ssp to simulate.")->required();
     simulate->add_option("--stopTime", "Simulation end.")->default_val(1.0);
     simulate->add_option("--startTime", "Simulation start.")->default_val(0.0);
     simulate->add_option("--stepSize", "Simulation stepSize.")->required();
+    simulate->add_option("--numThreads", "Number of threads to use (0 -> one per model instance, up to the number of cores).")->default_val(0);
     simulate->add_option("--rtf", "Target real time factor (non-positive number -> inf).")->default_val(-1);
     simulate->add_option("--parameterSet", "Name of SSP parameterSet to apply.");
     simulate->add_option("--csvConfig", "Path to CSV configuration.");
@@ -221,6 +223,7 @@ inline void parse_simulate_options(const CLI::App& app)
     const auto stepSize = app["--stepSize"]->as<double>();
     const bool parallel = !app["--noParallel"]->as<bool>();
     const auto sim = ss->load(std::make_unique<fixed_step_algorithm>(stepSize, parallel));
+    sim->set_num_threads(parallel ? app["--numThreads"]->as<size_t>() : 1, app["--pinThreads"]->as<bool>());
     setup_logging(app, *sim, csvName);
     setup_scenario(app, *sim);
 
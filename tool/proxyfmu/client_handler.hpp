@@ -231,6 +231,90 @@ inline void client_handler(std::unique_ptr<simple_socket::SimpleConnection> conn
                     const auto status = slave->set_boolean(vr, values);
                     sendStatus(*conn, status);
                 } break;
+                case ecos::proxy::opcodes::read_int64: {
+                    const auto flexVr = root[arg++].AsTypedVector();
+                    std::vector<fmilibcpp::value_ref> vr(flexVr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        vr[i] = flexVr[i].AsUInt32();
+                    }
+
+                    std::vector<int64_t> values(vr.size());
+                    const auto status = slave->get_int64(vr, values);
+
+                    sendStatusAndValues(*conn, status, values);
+                } break;
+                case ecos::proxy::opcodes::read_uint64: {
+                    const auto flexVr = root[arg++].AsTypedVector();
+                    std::vector<fmilibcpp::value_ref> vr(flexVr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        vr[i] = flexVr[i].AsUInt32();
+                    }
+
+                    std::vector<uint64_t> values(vr.size());
+                    const auto status = slave->get_uint64(vr, values);
+
+                    sendStatusAndValues(*conn, status, values);
+                } break;
+                case ecos::proxy::opcodes::read_float32: {
+                    const auto flexVr = root[arg++].AsTypedVector();
+                    std::vector<fmilibcpp::value_ref> vr(flexVr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        vr[i] = flexVr[i].AsUInt32();
+                    }
+
+                    std::vector<float> values(vr.size());
+                    const auto status = slave->get_float32(vr, values);
+
+                    sendStatusAndValues(*conn, status, values);
+                } break;
+                case ecos::proxy::opcodes::write_int64: {
+                    const auto flexVr = root[arg++].AsTypedVector();
+                    const auto flexValues = root[arg++].AsTypedVector();
+
+                    std::vector<fmilibcpp::value_ref> vr(flexVr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        vr[i] = flexVr[i].AsUInt32();
+                    }
+                    std::vector<int64_t> values(vr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        values[i] = flexValues[i].AsInt64();
+                    }
+
+                    const auto status = slave->set_int64(vr, values);
+                    sendStatus(*conn, status);
+                } break;
+                case ecos::proxy::opcodes::write_uint64: {
+                    const auto flexVr = root[arg++].AsTypedVector();
+                    const auto flexValues = root[arg++].AsTypedVector();
+
+                    std::vector<fmilibcpp::value_ref> vr(flexVr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        vr[i] = flexVr[i].AsUInt32();
+                    }
+                    std::vector<uint64_t> values(vr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        values[i] = flexValues[i].AsUInt64();
+                    }
+
+                    const auto status = slave->set_uint64(vr, values);
+                    sendStatus(*conn, status);
+                } break;
+                case ecos::proxy::opcodes::write_float32: {
+                    const auto flexVr = root[arg++].AsTypedVector();
+                    const auto flexValues = root[arg++].AsTypedVector();
+
+                    std::vector<fmilibcpp::value_ref> vr(flexVr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        vr[i] = flexVr[i].AsUInt32();
+                    }
+                    std::vector<float> values(vr.size());
+                    for (auto i = 0; i < flexVr.size(); i++) {
+                        values[i] = flexValues[i].AsFloat();
+                    }
+
+                    const auto status = slave->set_float32(vr, values);
+                    sendStatus(*conn, status);
+                } break;
                 default: {
                     spdlog::error("Unknown command: {}", func);
                     sendStatus(*conn, false);